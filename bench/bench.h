@@ -0,0 +1,81 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Helpers shared by the benchmarks: a generator for
+// synthetic databases, a wall clock timer and a peak
+// memory reading. Build a benchmark with, for example,
+// ./build.sh bench1 and run ./bin/371expenses-bench.
+// -----------------------------------------------------
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Writes a database in the 371expenses JSON format with the given number of
+// items spread evenly over the given number of categories.
+inline void writeSyntheticDatabase(const std::string &path, unsigned long items,
+                                   unsigned long categories = 20) {
+  static const char *tags[] = {"home", "uni", "food", "travel", "bills",
+                               "fun",  "gift", "car", "health", "work"};
+  std::ofstream f{path};
+  f << "{";
+  for (unsigned long c = 0; c < categories; c++) {
+    f << (c > 0 ? "," : "") << "\"Category" << c << "\":{";
+    bool first = true;
+    for (unsigned long i = c; i < items; i += categories) {
+      f << (first ? "" : ",") << "\"" << i << "\":{\"amount\":"
+        << (i % 1000) << "." << (10 + i % 90) << ",\"date\":\"2024-"
+        << (i % 12 < 9 ? "0" : "") << (i % 12 + 1) << "-"
+        << (i % 28 < 9 ? "0" : "") << (i % 28 + 1)
+        << "\",\"description\":\"Expense item number " << i
+        << "\",\"tags\":[\"" << tags[i % 10] << "\",\"" << tags[(i / 10) % 10]
+        << "\"]}";
+      first = false;
+    }
+    f << "}";
+  }
+  f << "}";
+}
+
+// Peak resident set size of this process in KiB, or 0 if unknown.
+inline long peakRssKb() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+class Timer {
+private:
+  std::chrono::steady_clock::time_point start;
+
+public:
+  Timer() : start(std::chrono::steady_clock::now()) {}
+
+  double ms() const {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+};
+
+#endif // BENCH_H
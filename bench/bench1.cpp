@@ -0,0 +1,77 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Compares the wall time and peak memory of the SAX based
+// ExpenseTracker::load against the previous approach of
+// parsing into a nlohmann::json DOM first. Run once per
+// loader, as peak memory is per process:
+//   ./bin/371expenses-bench sax 500000
+//   ./bin/371expenses-bench dom 500000
+//   ./bin/371expenses-bench check 10000
+// -----------------------------------------------------
+
+#include "bench.h"
+
+#include <cstdlib>
+#include <string>
+
+#include "../src/expensetracker.h"
+#include "../src/lib_json.hpp"
+
+// The loader as it was before DatabaseLoader: a full DOM, a temporary
+// Category per category and a copied Item per item.
+static void loadViaDom(ExpenseTracker &et, const std::string &filename) {
+  std::ifstream file(filename);
+  nlohmann::json j;
+  file >> j;
+  for (const auto &categoryJson : j.items()) {
+    Category tempCategory(categoryJson.key());
+    for (const auto &itemJson : categoryJson.value().items()) {
+      Item i(itemJson.key(), itemJson.value()["description"].get<std::string>(),
+             itemJson.value()["amount"].get<double>(),
+             Date(itemJson.value()["date"].get<std::string>()));
+      for (const auto &tag : itemJson.value()["tags"]) {
+        i.addTag(tag.get<std::string>());
+      }
+      tempCategory.addItem(i);
+    }
+    et.addCategory(tempCategory);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const std::string mode = argc > 1 ? argv[1] : "sax";
+  const unsigned long items = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+  const std::string path = "./bench/benchdatabase.json";
+
+  writeSyntheticDatabase(path, items);
+  const long baseline = peakRssKb();
+
+  ExpenseTracker et{};
+  Timer timer;
+  if (mode == "dom") {
+    loadViaDom(et, path);
+  } else if (mode == "sax") {
+    et.load(path);
+  } else if (mode == "check") {
+    ExpenseTracker dom{};
+    loadViaDom(dom, path);
+    et.load(path);
+    std::cout << (et == dom ? "identical" : "DIFFERENT") << std::endl;
+    return et == dom ? 0 : 1;
+  } else {
+    std::cerr << "usage: " << argv[0] << " sax|dom|check [items]" << std::endl;
+    return 1;
+  }
+  const double elapsed = timer.ms();
+
+  std::cout << mode << ": " << items << " items, " << elapsed << " ms, peak RSS "
+            << peakRssKb() << " KiB (" << peakRssKb() - baseline
+            << " KiB over baseline)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,48 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Compares loading and saving a JSON database with
+// loading and saving the same data as a binary snapshot.
+//   ./bin/371expenses-bench 500000
+// -----------------------------------------------------
+
+#include "bench.h"
+
+#include <cstdlib>
+#include <string>
+
+#include "../src/expensetracker.h"
+
+int main(int argc, char *argv[]) {
+  const unsigned long items = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+  const std::string jsonPath = "./bench/benchdatabase.json";
+  const std::string binaryPath = "./bench/benchdatabase.bin";
+
+  writeSyntheticDatabase(jsonPath, items);
+
+  ExpenseTracker et{};
+  Timer loadJson;
+  et.load(jsonPath);
+  std::cout << "load:       " << loadJson.ms() << " ms" << std::endl;
+
+  Timer saveJson;
+  et.save(jsonPath);
+  std::cout << "save:       " << saveJson.ms() << " ms" << std::endl;
+
+  Timer saveBinary;
+  et.saveBinary(binaryPath);
+  std::cout << "saveBinary: " << saveBinary.ms() << " ms" << std::endl;
+
+  ExpenseTracker et2{};
+  Timer loadBinary;
+  et2.loadBinary(binaryPath);
+  std::cout << "loadBinary: " << loadBinary.ms() << " ms" << std::endl;
+
+  std::cout << (et == et2 ? "identical" : "DIFFERENT") << std::endl;
+  return et == et2 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Compares writing Money amounts against formatting
+// the same amounts as doubles on a std::ostringstream,
+// as Item did before, and checks that both give the
+// same text.
+//   ./bin/371expenses-bench 1000000
+// -----------------------------------------------------
+
+#include "bench.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/money.h"
+#include "../src/writer.h"
+
+int main(int argc, char *argv[]) {
+  const unsigned long count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+  std::vector<Money> amounts;
+  amounts.reserve(count);
+  for (unsigned long i = 0; i < count; i++) {
+    amounts.push_back(Money::fromUnits((i % 10000) * 100 + (i % 7 == 0 ? 0 : i % 100)));
+  }
+
+  Timer streams;
+  std::string expected;
+  for (const Money &money : amounts) {
+    const double amount = money.toDouble();
+    std::ostringstream os;
+    if (std::floor(amount) == amount) {
+      os << std::fixed << std::setprecision(1) << amount;
+    } else {
+      os << amount;
+    }
+    expected += os.str();
+    expected += ',';
+  }
+  std::cout << "ostringstream: " << streams.ms() << " ms" << std::endl;
+
+  Timer direct;
+  StringWriter out;
+  for (const Money &money : amounts) {
+    money.write(out);
+    out.put(',');
+  }
+  const std::string actual = out.str();
+  std::cout << "Money::write:  " << direct.ms() << " ms" << std::endl;
+
+  std::cout << (actual == expected ? "identical" : "DIFFERENT") << std::endl;
+  return actual == expected ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Compares the scalar and AVX2 aggregate kernels over
+// synthetic amount and tag columns of 10^6 and 10^7
+// items, with and without a tag mask, and checks that
+// both give the same results.
+//   ./bin/371expenses-bench
+// -----------------------------------------------------
+
+#include "bench.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "../src/aggregate.h"
+
+typedef Aggregate (*Kernel)(const std::int64_t *, const std::uint64_t *, std::size_t,
+                            std::uint64_t);
+
+// Runs a kernel repeatedly and prints the items aggregated per second.
+static Aggregate run(const char *name, Kernel kernel, const std::vector<std::int64_t> &amounts,
+                     const std::vector<std::uint64_t> &tags, std::uint64_t mask) {
+  const int repeats = 10;
+  Aggregate result;
+  Timer timer;
+  for (int r = 0; r < repeats; r++) {
+    result = kernel(amounts.data(), tags.data(), amounts.size(), mask);
+  }
+  const double ms = timer.ms();
+  std::cout << "  " << name << ": " << ms / repeats << " ms, "
+            << amounts.size() * repeats / ms * 1000.0 << " items/s" << std::endl;
+  return result;
+}
+
+int main() {
+  bool identical = true;
+  for (std::size_t n : {std::size_t(1000000), std::size_t(10000000)}) {
+    std::vector<std::int64_t> amounts(n);
+    std::vector<std::uint64_t> tags(n);
+    for (std::size_t i = 0; i < n; i++) {
+      amounts[i] = static_cast<std::int64_t>((i * 2654435761u) % 100000);
+      tags[i] = std::uint64_t(1) << (i % 10);
+    }
+    for (std::uint64_t mask : {std::uint64_t(0), std::uint64_t(4)}) {
+      std::cout << n << " items, " << (mask == 0 ? "no tag" : "one tag in ten") << std::endl;
+      const Aggregate scalar = run("scalar", aggregateScalar, amounts, tags, mask);
+      if (!hasAvx2()) {
+        std::cout << "  avx2:   not supported" << std::endl;
+        continue;
+      }
+      const Aggregate avx2 = run("avx2  ", aggregateAvx2, amounts, tags, mask);
+      identical = identical && scalar.count == avx2.count && scalar.sum == avx2.sum &&
+                  scalar.min == avx2.min && scalar.max == avx2.max;
+    }
+  }
+  std::cout << (identical ? "identical" : "DIFFERENT") << std::endl;
+  return identical ? 0 : 1;
+}
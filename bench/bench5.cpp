@@ -0,0 +1,117 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Compares std::map, FlatMap and HashMap holding Items
+// by identifier, for 10^4, 10^5 and 10^6 items: inserting
+// in key order (as when loading) and in random order,
+// looking every key up in random order, iterating, and
+// the bytes allocated per item while inserting in key
+// order (which counts the vectors that were outgrown).
+//   ./bin/371expenses-bench
+// -----------------------------------------------------
+
+#include "bench.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/containers.h"
+#include "../src/item.h"
+
+static std::size_t allocated = 0;
+
+void *operator new(std::size_t size) {
+  allocated += size;
+  if (void *p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+// Runs every measurement for one container type and prints a line of results.
+// Inserting in random order is only timed up to maxShuffled items, as FlatMap
+// shifts half of its entries on average for each insert.
+template <typename Map>
+static void run(const char *name, const std::vector<std::string> &sorted,
+                const std::vector<std::string> &shuffled, std::size_t maxShuffled) {
+  const Item item("", "Expense item", Money(12.34), Date(2024, 12, 1));
+  Money sum;
+
+  std::size_t before = allocated;
+  Timer ordered;
+  Map map;
+  for (const std::string &key : sorted) {
+    map.insert(std::make_pair(key, item));
+  }
+  const double orderedMs = ordered.ms();
+  const double bytes = double(allocated - before) / sorted.size();
+
+  double randomMs = -1;
+  if (shuffled.size() <= maxShuffled) {
+    Timer random;
+    Map other;
+    for (const std::string &key : shuffled) {
+      other.insert(std::make_pair(key, item));
+    }
+    // Leaves the entries in key order, as the first iteration would.
+    other.begin();
+    randomMs = random.ms();
+  }
+
+  Timer lookup;
+  for (const std::string &key : shuffled) {
+    sum += map.find(key)->second.getAmount();
+  }
+  const double lookupMs = lookup.ms();
+
+  Timer iterate;
+  for (int r = 0; r < 10; r++) {
+    for (const auto &pair : map) {
+      sum += pair.second.getAmount();
+    }
+  }
+  const double iterateMs = iterate.ms() / 10;
+
+  std::cout << "  " << name << ": insert in order " << orderedMs << " ms, insert shuffled ";
+  if (randomMs < 0) {
+    std::cout << "skipped";
+  } else {
+    std::cout << randomMs << " ms";
+  }
+  std::cout << ", lookup " << lookupMs << " ms, iterate " << iterateMs
+            << " ms, " << bytes << " bytes/item (" << sum.str() << ")" << std::endl;
+}
+
+int main() {
+  std::mt19937 rng(371);
+  for (std::size_t n : {std::size_t(10000), std::size_t(100000), std::size_t(1000000)}) {
+    std::vector<std::string> sorted;
+    sorted.reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+      sorted.push_back(std::to_string(i));
+    }
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<std::string> shuffled(sorted);
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+    std::cout << n << " items" << std::endl;
+    run<std::map<std::string, Item>>("std::map", sorted, shuffled, n);
+    run<FlatMap<std::string, Item>>("FlatMap ", sorted, shuffled, 10000);
+    run<HashMap<std::string, Item>>("HashMap ", sorted, shuffled, n);
+  }
+  return 0;
+}
@@ -0,0 +1,71 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Measures loading a database and destroying the
+// ExpenseTracker: wall time, heap allocations and peak
+// memory. Items are allocated from each Category's Arena
+// unless built with -DEXPENSES_NO_ARENA, so build and run
+// it once each way, as peak memory is per process:
+//   bash build.sh bench6
+//   ./bin/371expenses-bench 1000000
+//   CXXFLAGS=-DEXPENSES_NO_ARENA bash build.sh bench6
+//   ./bin/371expenses-bench 1000000
+// -----------------------------------------------------
+
+#include "bench.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "../src/expensetracker.h"
+
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t size) {
+  allocations++;
+  if (void *p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+int main(int argc, char *argv[]) {
+  const unsigned long items = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const std::string path = "./bench/benchdatabase.json";
+
+  writeSyntheticDatabase(path, items);
+  const long baseline = peakRssKb();
+
+  std::unique_ptr<ExpenseTracker> et(new ExpenseTracker());
+  std::size_t before = allocations;
+  Timer load;
+  et->load(path);
+  const double loadMs = load.ms();
+  const std::size_t loadAllocations = allocations - before;
+  const long peak = peakRssKb();
+
+  Timer destroy;
+  et.reset();
+  const double destroyMs = destroy.ms();
+
+#ifdef EXPENSES_NO_ARENA
+  std::cout << "heap: ";
+#else
+  std::cout << "arena: ";
+#endif
+  std::cout << items << " items, load " << loadMs << " ms (" << loadAllocations
+            << " allocations, " << double(loadAllocations) / items << " per item), destroy "
+            << destroyMs << " ms, peak RSS " << peak << " KiB (" << peak - baseline
+            << " KiB over baseline)" << std::endl;
+  return 0;
+}
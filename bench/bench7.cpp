@@ -0,0 +1,53 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Measures searching item descriptions as the search
+// action does once per process, against building the
+// trigram index first (as every search did before the
+// index was left until a category's second search), and
+// against searching with the index already built.
+//   bash build.sh bench7
+//   ./bin/371expenses-bench 300000
+// -----------------------------------------------------
+
+#include "bench.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../src/expensetracker.h"
+
+// Searches every category for a query and prints how long it took.
+static std::size_t run(const char *name, const ExpenseTracker &et, const std::string &query) {
+  Timer timer;
+  const std::size_t found =
+      et.findItems([&](const Category &c) { return c.search(query); }).size();
+  std::cout << "  " << name << ": " << timer.ms() << " ms, " << found << " found"
+            << std::endl;
+  return found;
+}
+
+int main(int argc, char *argv[]) {
+  const unsigned long items = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 300000;
+  const std::string path = "./bench/benchdatabase.json";
+  writeSyntheticDatabase(path, items);
+
+  bool identical = true;
+  for (const std::string query : {"number 4242", "xyzq"}) {
+    ExpenseTracker et;
+    et.load(path);
+    std::cout << items << " items, query \"" << query << "\"" << std::endl;
+    const std::size_t scan = run("one search (scan)          ", et, query);
+    const std::size_t build = run("second search (build index)", et, query);
+    const std::size_t indexed = run("later search (index built) ", et, query);
+    identical = identical && scan == build && scan == indexed;
+  }
+  std::cout << (identical ? "identical" : "DIFFERENT") << std::endl;
+  return identical ? 0 : 1;
+}
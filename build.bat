@@ -3,9 +3,11 @@
 SET bin_dir=bin
 SET src_dir=src
 SET tests_dir=tests
-SET source_files=%src_dir%\371expenses.cpp %src_dir%\expensetracker.cpp %src_dir%\category.cpp %src_dir%\item.cpp %src_dir%\date.cpp
+SET bench_dir=bench
+SET source_files=%src_dir%\371expenses.cpp %src_dir%\expensetracker.cpp %src_dir%\category.cpp %src_dir%\item.cpp %src_dir%\date.cpp %src_dir%\databaseloader.cpp %src_dir%\mappedfile.cpp %src_dir%\binaryio.cpp %src_dir%\journal.cpp %src_dir%\writer.cpp %src_dir%\money.cpp %src_dir%\aggregate.cpp %src_dir%\threadpool.cpp %src_dir%\report.cpp %src_dir%\top.cpp %src_dir%\filter.cpp %src_dir%\tags.cpp %src_dir%\arena.cpp
 SET main_file=%src_dir%\main.cpp
 SET executable=%bin_dir%\371expenses.exe
+SET optimise=
 
 IF "%1"=="" GOTO compile
 
@@ -17,13 +19,21 @@ IF %testStr%==test (
   SET executable=%bin_dir%\371expenses-test.exe
 
   IF NOT EXIST %bin_dir%\catch.o (
-     g++ --std=c++14 -c %src_dir%\lib_catch_main.cpp -o %bin_dir%\catch.o
+     g++ --std=c++17 -c %src_dir%\lib_catch_main.cpp -o %bin_dir%\catch.o
   )
 )
+SET benchStr=%1%
+SET benchStr=%benchStr:~0,5%
+IF %benchStr%==bench (
+  SET source_files=%source_files% %bench_dir%\%1%.cpp
+  SET main_file=
+  SET executable=%bin_dir%\371expenses-bench.exe
+  SET optimise=-O2
+)
 
 :compile
 IF NOT EXIST %bin_dir% MKDIR %bin_dir%
 IF EXIST %executable% DEL %executable%
-g++ --std=c++14 -pedantic -Wall %source_files% %main_file% -o %executable%
+g++ --std=c++17 -pedantic -Wall -pthread %optimise% %CXXFLAGS% %source_files% %main_file% -o %executable%
 
 :end
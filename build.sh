@@ -5,15 +5,17 @@
 BIN_DIR="bin"
 SRC_DIR="src"
 TESTS_DIR="tests"
-SOURCE_FILES="${SRC_DIR}/371expenses.cpp ${SRC_DIR}/expensetracker.cpp ${SRC_DIR}/category.cpp ${SRC_DIR}/item.cpp ${SRC_DIR}/date.cpp"
+BENCH_DIR="bench"
+SOURCE_FILES="${SRC_DIR}/371expenses.cpp ${SRC_DIR}/expensetracker.cpp ${SRC_DIR}/category.cpp ${SRC_DIR}/item.cpp ${SRC_DIR}/date.cpp ${SRC_DIR}/databaseloader.cpp ${SRC_DIR}/mappedfile.cpp ${SRC_DIR}/binaryio.cpp ${SRC_DIR}/journal.cpp ${SRC_DIR}/writer.cpp ${SRC_DIR}/money.cpp ${SRC_DIR}/aggregate.cpp ${SRC_DIR}/threadpool.cpp ${SRC_DIR}/report.cpp ${SRC_DIR}/top.cpp ${SRC_DIR}/filter.cpp ${SRC_DIR}/tags.cpp ${SRC_DIR}/arena.cpp"
 MAIN_FILE="${SRC_DIR}/main.cpp"
 EXECUTABLE="./${BIN_DIR}/371expenses"
+OPTIMISE=""
 
 set -x
 cd "${0%/*}"
 
 if [ $# -gt 1 ]; then
-  echo "Unknown arguments!" "Only one argument accepted, and must begin with test"
+  echo "Unknown arguments!" "Only one argument accepted, and must begin with test or bench"
   exit
 elif [ $# -eq 1 ]; then
   if [[ $1 == test* ]]; then
@@ -23,11 +25,16 @@ elif [ $# -eq 1 ]; then
 
     # Do we need to compile Catch2?
     if [ ! -f ./${BIN_DIR}/catch.o ]; then
-      g++ --std=c++14 -c ./src/lib_catch_main.cpp -o ${MAIN_FILE}
+      g++ --std=c++17 -c ./src/lib_catch_main.cpp -o ${MAIN_FILE}
     fi
+  elif [[ $1 == bench* ]]; then
+    SOURCE_FILES="${SOURCE_FILES} ./${BENCH_DIR}/$1.cpp"
+    MAIN_FILE=""
+    EXECUTABLE="./${BIN_DIR}/371expenses-bench"
+    OPTIMISE="-O2"
   fi
 fi
 
 mkdir -p ${BIN_DIR}
 rm ${EXECUTABLE} 2> /dev/null
-g++ --std=c++14 -pedantic -Wall  ${SOURCE_FILES} ${MAIN_FILE} -o ${EXECUTABLE}
+g++ --std=c++17 -pedantic -Wall -pthread ${OPTIMISE} ${CXXFLAGS} ${SOURCE_FILES} ${MAIN_FILE} -o ${EXECUTABLE}
@@ -8,6 +8,10 @@
 // -----------------------------------------------------
 
 #include "371expenses.h"
+#include "filter.h"
+#include "journal.h"
+#include "text.h"
+#include "writer.h"
 #include "lib_cxxopts.hpp"
 #include <fstream>
 #include <sstream>
@@ -19,8 +23,10 @@
  * @brief Main application entry point.
  *
  * This function sets up the command line options, parses the arguments, loads the ExpenseTracker database,
- * and then performs one of several actions (create, json, update, delete, sum) based on the parsed action argument.
- * After performing the requested action, any changes to the database are saved.
+ * and then performs one of several actions (create, json, update, delete, sum, stats, report, top, search, compact)
+ * based on the parsed action
+ * argument. After performing an action that changes the database, the changes are saved, or, if the journal
+ * flag is given, appended to the database's journal.
  *
  * The function also performs error checking for missing or invalid arguments and prints appropriate error messages.
  *
@@ -41,33 +47,65 @@ int App::run(int argc, char *argv[]) {
 
   // Retrieve the database filename from the command line arguments.
   const std::string db = args["db"].as<std::string>();
+  const Format format = parseFormatArgument(args, db);
 
-  // Construct an ExpenseTracker object and load the database.
+  // Construct an ExpenseTracker object and load the database, in whichever
+  // format the file is in. JSON databases are opened lazily, so that commands
+  // about one category only parse that category.
   ExpenseTracker etObj{};
-  etObj.load(db);
+  etObj.setThreads(args["threads"].as<unsigned int>());
+  if (ExpenseTracker::isBinary(db)) {
+    etObj.loadBinary(db);
+  } else {
+    etObj.open(db);
+  }
+
+  // Every change is recorded, so that with --journal it can be appended to the
+  // database's journal instead of rewriting the whole database.
+  Journal journal(db);
 
   // Parse the action argument to decide what action to perform.
   const Action a = parseActionArgument(args);
+
+  // The optional date range and tag that the json, sum, stats, report, top and search actions are
+  // limited to.
+  Date from = Date::earliest();
+  Date to = Date::latest();
+  const bool ranged = parseDateRange(args, from, to);
+  const bool tagged = (a == Action::JSON || a == Action::SUM || a == Action::STATS ||
+                       a == Action::REPORT || a == Action::TOP || a == Action::SEARCH) &&
+                      args.count("tag");
+  const std::string tag = tagged ? args["tag"].as<std::string>() : "";
+  // An optional filter expression that further limits them, or that chooses the
+  // items the delete and update actions change.
+  const bool filtered = args.count("where");
+  const Filter where(filtered ? args["where"].as<std::string>() : "");
+  const ExpenseTracker::ItemSelector select = [&](const Category &cObj) {
+    return filtered ? where.select(cObj, from, to, tag) : selectItems(cObj, tag, from, to);
+  };
   switch (a) {
     case Action::CREATE:
       if (args.count("category")) {
         std::string category = args["category"].as<std::string>();
         etObj.newCategory(category);  // Create or ensure the category exists.        
+        journal.newCategory(category);
         if (args.count("item")) {
           std::string item = args["item"].as<std::string>();
           if (args.count("description")) {
             std::string description = args["description"].as<std::string>();
             if (args.count("amount")) {
-              double amount = std::stod(args["amount"].as<std::string>());
+              Money amount = Money::parse(args["amount"].as<std::string>());
               Date date;
               if (args.count("date")) {
                 date = Date(args["date"].as<std::string>());
               }
               etObj.getCategory(category).newItem(item, description, amount, date);
+              journal.newItem(category, item, description, amount, date);
       
               if (args.count("tag")) {
                 std::string tag = args["tag"].as<std::string>();
                 etObj.getCategory(category).getItem(item).addTag(tag);
+                journal.addTag(category, item, tag);
               }
             } else {
               std::cerr << "Error: missing amount argument(s)." << std::endl;
@@ -92,6 +130,10 @@ int App::run(int argc, char *argv[]) {
           std::cerr << "Error: missing category argument(s)." << std::endl;
           return 1;
         }
+        if (ranged || tagged || filtered) {
+          std::cerr << "Error: from, to, tag and where argument(s) cannot be used with an item." << std::endl;
+          return 1;
+        }
         std::string category = args["category"].as<std::string>();
         try {
           // Attempt to output the JSON for the category.
@@ -113,7 +155,9 @@ int App::run(int argc, char *argv[]) {
       else if (args.count("category")) {
         std::string category = args["category"].as<std::string>();
         try {
-          std::cout << getJSON(etObj, category) << std::endl;
+          std::cout << (ranged || tagged || filtered ? getJSON(etObj, category, select)
+                                                     : getJSON(etObj, category))
+                    << std::endl;
         } catch (const std::out_of_range& e) {
           std::cerr << "Error: invalid category argument(s)." << std::endl;
           return 1;
@@ -122,7 +166,8 @@ int App::run(int argc, char *argv[]) {
       // If neither category nor item are specified, output the entire database JSON.
       else {
         try {
-          std::cout << getJSON(etObj) << std::endl;
+          std::cout << (ranged || tagged || filtered ? getJSON(etObj, select) : getJSON(etObj))
+                    << std::endl;
         } catch (...) {
           std::cerr << "Error: invalid JSON." << std::endl;
           return 1;
@@ -131,7 +176,40 @@ int App::run(int argc, char *argv[]) {
       break;
 
     case Action::UPDATE:
-      if (args.count("item")) {
+      if (filtered) {
+        // Update every expense item matching the filter, in a specific category
+        // or in all categories if no category is specified.
+        std::vector<std::pair<std::string, std::string>> found;
+        try {
+          found = findItems(etObj, args, select);
+        } catch (const std::out_of_range& e) {
+          std::cerr << "Error: invalid category argument(s)." << std::endl;
+          return 1;
+        }
+        for (const auto &match : found) {
+          Item &iObj = etObj.getCategory(match.first).getItem(match.second);
+          if (args.count("description")) {
+            std::string description = args["description"].as<std::string>();
+            iObj.setDescription(description);
+            journal.setDescription(match.first, match.second, description);
+          }
+          if (args.count("amount")) {
+            Money amount = Money::parse(args["amount"].as<std::string>());
+            iObj.setAmount(amount);
+            journal.setAmount(match.first, match.second, amount);
+          }
+          if (args.count("date")) {
+            Date date(args["date"].as<std::string>());
+            iObj.setDate(date);
+            journal.setDate(match.first, match.second, date);
+          }
+          if (args.count("tag")) {
+            std::string tag = args["tag"].as<std::string>();
+            iObj.addTag(tag);
+            journal.addTag(match.first, match.second, tag);
+          }
+        }
+      } else if (args.count("item")) {
         if (!args.count("category")) {
           throw std::invalid_argument("Category must be specified with item");
         }
@@ -152,17 +230,24 @@ int App::run(int argc, char *argv[]) {
         }
         // Update the expense item attributes if provided.
         if (args.count("description")) {
-          etObj.getCategory(category).getItem(item).setDescription(args["description"].as<std::string>());
+          std::string description = args["description"].as<std::string>();
+          etObj.getCategory(category).getItem(item).setDescription(description);
+          journal.setDescription(category, item, description);
         }
         if (args.count("amount")) {
-          etObj.getCategory(category).getItem(item).setAmount(std::stod(args["amount"].as<std::string>()));
+          Money amount = Money::parse(args["amount"].as<std::string>());
+          etObj.getCategory(category).getItem(item).setAmount(amount);
+          journal.setAmount(category, item, amount);
         }
         if (args.count("date")) {
-          etObj.getCategory(category).getItem(item).setDate(Date(args["date"].as<std::string>()));
+          Date date(args["date"].as<std::string>());
+          etObj.getCategory(category).getItem(item).setDate(date);
+          journal.setDate(category, item, date);
         }
         if (args.count("tag")) {
           std::string tag = args["tag"].as<std::string>();
           etObj.getCategory(category).getItem(item).addTag(tag);
+          journal.addTag(category, item, tag);
         }
       } else {
         throw std::invalid_argument("Category, item, or tag must be specified with update");
@@ -170,8 +255,31 @@ int App::run(int argc, char *argv[]) {
       break;
 
     case Action::DELETE:
-      // Deletion based on tag, item, or category.
-      if (args.count("tag")) {
+      // Deletion based on a filter, tag, item, or category.
+      if (filtered) {
+        // Delete every expense item matching the filter, or with a tag argument,
+        // the tag from each of them that carries it.
+        std::vector<std::pair<std::string, std::string>> found;
+        try {
+          found = findItems(etObj, args, select);
+        } catch (const std::out_of_range& e) {
+          std::cerr << "Error: invalid category argument(s)." << std::endl;
+          return 1;
+        }
+        for (const auto &match : found) {
+          Category &cObj = etObj.getCategory(match.first);
+          if (args.count("tag")) {
+            std::string tag = args["tag"].as<std::string>();
+            if (cObj.getItem(match.second).containsTag(tag)) {
+              cObj.getItem(match.second).deleteTag(tag);
+              journal.deleteTag(match.first, match.second, tag);
+            }
+          } else {
+            cObj.deleteItem(match.second);
+            journal.deleteItem(match.first, match.second);
+          }
+        }
+      } else if (args.count("tag")) {
         if (!args.count("category")) {
           throw std::invalid_argument("Category must be specified with tag");
         }
@@ -185,6 +293,7 @@ int App::run(int argc, char *argv[]) {
         }
         std::string tag = args["tag"].as<std::string>();
         etObj.getCategory(category).getItem(item).deleteTag(tag);
+        journal.deleteTag(category, item, tag);
       } else if (args.count("item")) {
         if (!args.count("category")) {
           throw std::invalid_argument("Category must be specified with item");
@@ -192,9 +301,11 @@ int App::run(int argc, char *argv[]) {
         std::string category = args["category"].as<std::string>();
         std::string item = args["item"].as<std::string>();
         etObj.getCategory(category).deleteItem(item);
+        journal.deleteItem(category, item);
       } else if (args.count("category")) {
         std::string category = args["category"].as<std::string>();
         etObj.deleteCategory(category);
+        journal.deleteCategory(category);
       } else {
         throw std::invalid_argument("Category, item, or tag must be specified with delete");
       }
@@ -205,23 +316,169 @@ int App::run(int argc, char *argv[]) {
       if (args.count("category")) {
         std::string category = args["category"].as<std::string>();
         try {
-          double sum = etObj.getCategory(category).getSum();
-          std::cout << sum << std::endl;
+          const Category &cObj = etObj.getCategory(category);
+          if (filtered) {
+            Money sum;
+            for (const Item *item : select(cObj)) {
+              sum += item->getAmount();
+            }
+            printSum(sum);
+          } else if (tagged && ranged) {
+            printSum(cObj.getSum(from, to, tag));
+          } else if (tagged) {
+            printSum(cObj.getSumForTag(tag));
+          } else {
+            printSum(ranged ? cObj.getSum(from, to) : cObj.getSum());
+          }
         } catch (const std::out_of_range& e) {
           std::cerr << "Error: invalid category argument(s)." << std::endl;
           return 1;
         }
       } else {
-        double sum = etObj.getSum();
-        std::cout << sum << std::endl;
+        if (filtered) {
+          printSum(etObj.getSum(select));
+        } else if (tagged && ranged) {
+          printSum(etObj.getSum(from, to, tag));
+        } else if (tagged) {
+          printSum(etObj.getSumForTag(tag));
+        } else {
+          printSum(ranged ? etObj.getSum(from, to) : etObj.getSum());
+        }
       }
       break;
 
+    case Action::STATS:
+      // Statistics for a specific category or overall if no category is specified.
+      if (args.count("category")) {
+        std::string category = args["category"].as<std::string>();
+        try {
+          const Category &cObj = etObj.getCategory(category);
+          printStats(tagged ? cObj.getStats(from, to, tag) : cObj.getStats(from, to));
+        } catch (const std::out_of_range& e) {
+          std::cerr << "Error: invalid category argument(s)." << std::endl;
+          return 1;
+        }
+      } else {
+        printStats(tagged ? etObj.getStats(from, to, tag) : etObj.getStats(from, to));
+      }
+      break;
+
+    case Action::REPORT:
+      // Group the expenses of a specific category, or of all categories if no
+      // category is specified, and stream the groups to std::cout.
+      if (args.count("group-by")) {
+        const auto groupBy = Report::parseGroupBy(args["group-by"].as<std::string>());
+        const Output output = parseOutputArgument(args);
+        Report report(groupBy, tag);
+        if (args.count("category")) {
+          std::string category = args["category"].as<std::string>();
+          try {
+            const Category &cObj = etObj.getCategory(category);
+            report.add(cObj, select(cObj));
+          } catch (const std::out_of_range& e) {
+            std::cerr << "Error: invalid category argument(s)." << std::endl;
+            return 1;
+          }
+        } else {
+          report = etObj.report(groupBy, tag, select);
+        }
+        StreamWriter out(std::cout);
+        if (output == Output::CSV) {
+          report.writeCsv(out);
+        } else {
+          report.write(out);
+          out.put('\n');
+        }
+      } else {
+        std::cerr << "Error: missing group-by argument(s)." << std::endl;
+        return 1;
+      }
+      break;
+
+    case Action::TOP:
+      // The largest or most recent expenses of a specific category, or of all
+      // categories if no category is specified.
+      {
+        const Top::Order by = Top::parseOrder(args["by"].as<std::string>());
+        const std::size_t limit = args["limit"].as<unsigned int>();
+        Top top(by, limit);
+        if (args.count("category")) {
+          std::string category = args["category"].as<std::string>();
+          try {
+            const Category &cObj = etObj.getCategory(category);
+            top.add(cObj, select(cObj));
+          } catch (const std::out_of_range& e) {
+            std::cerr << "Error: invalid category argument(s)." << std::endl;
+            return 1;
+          }
+        } else {
+          top = etObj.top(by, limit, select);
+        }
+        StreamWriter out(std::cout);
+        top.write(out);
+        out.put('\n');
+      }
+      break;
+
+    case Action::SEARCH:
+      // Output the JSON for the expenses whose description contains the query,
+      // in a specific category or in all categories if no category is specified.
+      if (args.count("query")) {
+        const std::string query = args["query"].as<std::string>();
+        const ExpenseTracker::ItemSelector matches = [&](const Category &cObj) {
+          // Look the tag up once the category is parsed, so that its tags have ids.
+          TagId tagId = TagDictionary::NONE;
+          TagDictionary::find(tag, tagId);
+          std::vector<const Item *> selection;
+          for (const Item *item : cObj.search(query)) {
+            if (!(item->getDate() < from) && !(to < item->getDate()) &&
+                (tag.empty() || item->containsTagId(tagId))) {
+              selection.push_back(item);
+            }
+          }
+          return selection;
+        };
+        if (args.count("category")) {
+          std::string category = args["category"].as<std::string>();
+          try {
+            std::cout << getJSON(etObj, category, matches) << std::endl;
+          } catch (const std::out_of_range& e) {
+            std::cerr << "Error: invalid category argument(s)." << std::endl;
+            return 1;
+          }
+        } else {
+          std::cout << getJSON(etObj, matches) << std::endl;
+        }
+      } else {
+        std::cerr << "Error: missing query argument(s)." << std::endl;
+        return 1;
+      }
+      break;
+
+    case Action::COMPACT:
+      // Loading has already replayed the journal; the save below folds it
+      // into the database and removes it.
+      break;
+
     default:
       throw std::runtime_error("unknown action");
   }
-  // Save any changes to the database.
-  etObj.save(db);
+  // There is nothing to save after the read-only json, sum, stats, report, top
+  // and search actions, or if the action did not change anything. Compacting
+  // always saves.
+  if (a == Action::JSON || a == Action::SUM || a == Action::STATS || a == Action::REPORT ||
+      a == Action::TOP || a == Action::SEARCH || (a != Action::COMPACT && !etObj.isDirty())) {
+    return 0;
+  }
+  // With --journal, append the changes to the journal. Otherwise save the whole
+  // database, in the requested format, which also folds in any journal.
+  if (args.count("journal") && a != Action::COMPACT) {
+    journal.commit();
+  } else if (format == Format::BINARY) {
+    etObj.saveBinary(db);
+  } else {
+    etObj.save(db);
+  }
   return 0;
 }
 
@@ -229,7 +486,7 @@ int App::run(int argc, char *argv[]) {
  * @brief Configures and returns a cxxopts::Options instance for parsing command line arguments.
  *
  * This function defines the available command line options (such as db, action, category, description, amount,
- * item, date, tag, and help) and their expected types, as well as default values where appropriate.
+ * item, date, tag, from, to, where, group-by, output, by, limit, query, format, journal, threads, and help) and their expected types, as well as default values where appropriate.
  *
  * @return cxxopts::Options A configured cxxopts::Options object.
  */
@@ -241,13 +498,14 @@ cxxopts::Options App::cxxoptsSetup() {
       cxxopts::value<std::string>()->default_value("database.json"))(
 
       "action",
-      "Action to take, can be: 'create', 'json', 'update', 'delete', 'sum'.",
+      "Action to take, can be: 'create', 'json', 'update', 'delete', 'sum', "
+      "'stats', 'report', 'top', 'search', 'compact'.",
       cxxopts::value<std::string>())(
 
       "category",
-      "Apply action (create, json, update, delete, sum) to a category. If you "
-      "want to add a category, set the action argument to 'create' and the "
-      "category argument to your chosen category identifier.",
+      "Apply action (create, json, update, delete, sum, stats, report, top, "
+      "search) to a category. If you want to add a category, set the action argument to "
+      "'create' and the category argument to your chosen category identifier.",
       cxxopts::value<std::string>())(
 
       "description",
@@ -287,10 +545,74 @@ cxxopts::Options App::cxxoptsSetup() {
       "set the action argument to 'create', the category argument to your "
       "chosen category identifier, the item argument to your chosen item "
       "identifier, and the tag argument to a single tag 'tag' or comma "
-      "seperated list of tags: 'tag1,tag2'). The action update/sum/json are "
-      "unsupported here.",
+      "seperated list of tags: 'tag1,tag2'). With the sum, stats, report, top, "
+      "search and json actions, limit them to expense items carrying the tag. The action "
+      "update is unsupported here.",
+      cxxopts::value<std::string>())(
+
+      "from",
+      "Limit the json, sum, stats, report, top and search actions to expense "
+      "items dated on or after the given date (e.g. '2024-11-01').",
       cxxopts::value<std::string>())(
 
+      "to",
+      "Limit the json, sum, stats, report, top and search actions to expense "
+      "items dated on or before the given date (e.g. '2024-11-30').",
+      cxxopts::value<std::string>())(
+
+      "where",
+      "Limit the json, sum, report and top actions to expense items matching "
+      "a filter, or choose the items that the delete and update actions "
+      "change, e.g. 'amount > 20 && tag:uni && date >= 2024-01-01 && desc ~ "
+      "\"coffee\"'. Conditions on amount and date use ==, !=, <, <=, > and "
+      ">=, and descriptions ~ (contains), == and !=, ignoring case. They "
+      "combine with &&, || and !, and group with brackets. With delete, a "
+      "tag argument deletes the tag from the matching items instead.",
+      cxxopts::value<std::string>())(
+
+      "group-by",
+      "Comma separated list of what the report action groups expenses by, in "
+      "order, from 'month', 'category' and 'tag' (e.g. 'month,category'). "
+      "Each group's count and sum is printed.",
+      cxxopts::value<std::string>())(
+
+      "output",
+      "Format the report action prints in, can be: 'json', 'csv'. Defaults to "
+      "'json'.",
+      cxxopts::value<std::string>()->default_value("json"))(
+
+      "by",
+      "What the top action ranks expenses by, can be: 'amount' (largest "
+      "first), 'date' (most recent first). Defaults to 'amount'.",
+      cxxopts::value<std::string>()->default_value("amount"))(
+
+      "limit",
+      "Number of expenses the top action prints. Defaults to 10.",
+      cxxopts::value<unsigned int>()->default_value("10"))(
+
+      "query",
+      "Text the search action looks for in expense item descriptions, "
+      "ignoring case (e.g. 'costa').",
+      cxxopts::value<std::string>())(
+
+      "format",
+      "Format to save the database in, can be: 'json', 'binary'. Defaults to "
+      "'binary' if the db filename ends in '.bin', and 'json' otherwise. "
+      "Either format is detected automatically when loading.",
+      cxxopts::value<std::string>())(
+
+      "journal",
+      "Append changes made by create, update and delete to the database's "
+      "journal ('<db>.journal') instead of rewriting the whole database. The "
+      "journal is replayed whenever the database is loaded, and folded back "
+      "into it by the 'compact' action or any save without this flag.")(
+
+      "threads",
+      "Number of threads that parse and total categories in parallel for the "
+      "sum, stats, report, top and json actions, or 0 for one per core. "
+      "Results do not depend on the number of threads.",
+      cxxopts::value<unsigned int>()->default_value("1"))(
+
       "h,help", "Print usage.");
 
   return cxxopts;
@@ -300,8 +622,8 @@ cxxopts::Options App::cxxoptsSetup() {
  * @brief Parses the action argument from the command line in a case-insensitive manner.
  *
  * This function converts the provided action argument to lowercase and matches it against known actions
- * ("create", "json", "update", "delete", "sum"). If the argument does not match any valid action,
- * an std::invalid_argument exception is thrown.
+ * ("create", "json", "update", "delete", "sum", "stats", "report", "top", "search", "compact"). If the
+ * argument does not match any valid action, an std::invalid_argument exception is thrown.
  *
  * @param args The cxxopts::ParseResult containing the command line arguments.
  * @return App::Action The corresponding action enum value.
@@ -310,15 +632,64 @@ cxxopts::Options App::cxxoptsSetup() {
 App::Action App::parseActionArgument(cxxopts::ParseResult &args) {
   std::string input = args["action"].as<std::string>();
   // Convert the input string to lowercase.
-  transform(input.begin(), input.end(), input.begin(), ::tolower); 
+  transform(input.begin(), input.end(), input.begin(), lower); 
   if (input == "create") return Action::CREATE;
   if (input == "json") return Action::JSON;
   if (input == "update") return Action::UPDATE;
   if (input == "delete") return Action::DELETE;
   if (input == "sum") return Action::SUM;
+  if (input == "stats") return Action::STATS;
+  if (input == "report") return Action::REPORT;
+  if (input == "top") return Action::TOP;
+  if (input == "search") return Action::SEARCH;
+  if (input == "compact") return Action::COMPACT;
   throw std::invalid_argument("action");
 }
 
+/**
+ * @brief Determines the format the database should be saved in.
+ *
+ * The format argument is matched case-insensitively against "json" and "binary". If it is not
+ * given, databases whose filename ends in ".bin" are saved as binary snapshots and all others as JSON.
+ *
+ * @param args The cxxopts::ParseResult containing the command line arguments.
+ * @param db The database filename.
+ * @return App::Format The format to save the database in.
+ * @throws std::invalid_argument if an invalid format string is provided.
+ */
+App::Format App::parseFormatArgument(cxxopts::ParseResult &args, const std::string &db) {
+  if (args.count("format")) {
+    std::string input = args["format"].as<std::string>();
+    transform(input.begin(), input.end(), input.begin(), lower);
+    if (input == "json") return Format::JSON;
+    if (input == "binary") return Format::BINARY;
+    throw std::invalid_argument("format");
+  }
+  const std::string extension = ".bin";
+  if (db.size() >= extension.size() &&
+      db.compare(db.size() - extension.size(), extension.size(), extension) == 0) {
+    return Format::BINARY;
+  }
+  return Format::JSON;
+}
+
+/**
+ * @brief Determines the format the report action prints in.
+ *
+ * The output argument is matched case-insensitively against "json" and "csv".
+ *
+ * @param args The cxxopts::ParseResult containing the command line arguments.
+ * @return App::Output The format to print the report in.
+ * @throws std::invalid_argument if an invalid output string is provided.
+ */
+App::Output App::parseOutputArgument(cxxopts::ParseResult &args) {
+  std::string input = args["output"].as<std::string>();
+  transform(input.begin(), input.end(), input.begin(), lower);
+  if (input == "json") return Output::JSON;
+  if (input == "csv") return Output::CSV;
+  throw std::invalid_argument("output");
+}
+
 /**
  * @brief Returns the JSON representation of the entire ExpenseTracker.
  *
@@ -341,7 +712,7 @@ std::string App::getJSON(ExpenseTracker &etObj) {
  * @return std::string The JSON string representation of the specified Category.
  */
 std::string App::getJSON(ExpenseTracker &etObj, const std::string &c) {
-  auto cObj = etObj.getCategory(c);
+  const Category &cObj = etObj.getCategory(c);
   return cObj.str();
 }
 
@@ -358,6 +729,145 @@ std::string App::getJSON(ExpenseTracker &etObj, const std::string &c) {
 std::string App::getJSON(ExpenseTracker &etObj, 
                          const std::string &c,
                          const std::string &id) {
-  auto iObj = etObj.getCategory(c).getItem(id);
+  const Item &iObj = etObj.getCategory(c).getItem(id);
   return iObj.str();
 }
+
+/**
+ * @brief Returns the JSON representation of the chosen expenses.
+ *
+ * @param etObj The ExpenseTracker object.
+ * @param select Chooses the items of each category to include.
+ * @return std::string The JSON string, with only the categories that have chosen expenses.
+ */
+std::string App::getJSON(ExpenseTracker &etObj, const ExpenseTracker::ItemSelector &select) {
+  StringWriter out;
+  etObj.write(out, select);
+  return out.str();
+}
+
+/**
+ * @brief Returns the JSON representation of the chosen expenses of a category.
+ *
+ * @param etObj The ExpenseTracker object.
+ * @param c The category identifier.
+ * @param select Chooses the items of the category to include.
+ * @return std::string The JSON string of the category, with only the chosen expenses.
+ * @throws std::out_of_range if the category does not exist.
+ */
+std::string App::getJSON(ExpenseTracker &etObj, const std::string &c,
+                         const ExpenseTracker::ItemSelector &select) {
+  const Category &cObj = etObj.getCategory(c);
+  StringWriter out;
+  cObj.write(out, select(cObj));
+  return out.str();
+}
+
+/**
+ * @brief Chooses the items of a category that the json and sum actions are limited to.
+ *
+ * Without a tag, this is every item in the date range.
+ *
+ * @param cObj The Category.
+ * @param tag The tag the items must carry, or an empty string for any.
+ * @param from The first date included.
+ * @param to The last date included.
+ * @return std::vector<const Item*> The chosen items.
+ */
+std::vector<const Item *> App::selectItems(const Category &cObj, const std::string &tag,
+                                           const Date &from, const Date &to) {
+  return tag.empty() ? cObj.getItems(from, to) : cObj.getItems(from, to, tag);
+}
+
+/**
+ * @brief Finds the items that the delete and update actions change when given a filter.
+ *
+ * These are the chosen items of the category argument, or of every category if there is none.
+ *
+ * @param et The ExpenseTracker.
+ * @param args The parsed command line arguments.
+ * @param select Chooses the items of each category.
+ * @return std::vector<std::pair<std::string, std::string>> The category and item identifier of each item.
+ * @throws std::out_of_range if the category argument is not a category.
+ */
+std::vector<std::pair<std::string, std::string>> App::findItems(
+    ExpenseTracker &et, cxxopts::ParseResult &args, const ExpenseTracker::ItemSelector &select) {
+  if (!args.count("category")) {
+    return et.findItems(select);
+  }
+  const Category &cObj = et.getCategory(args["category"].as<std::string>());
+  std::vector<std::pair<std::string, std::string>> found;
+  for (const Item *item : select(cObj)) {
+    found.push_back(std::make_pair(cObj.getIdent(), item->getIdent()));
+  }
+  return found;
+}
+
+/**
+ * @brief Reads the optional from and to arguments limiting the json and sum actions.
+ *
+ * Either end of the range may be left out, in which case from and to are left unchanged.
+ *
+ * @param args The parsed command line arguments.
+ * @param from Receives the first date included, if given.
+ * @param to Receives the last date included, if given.
+ * @return true if either argument was given.
+ * @throws std::invalid_argument if a date is not a valid "YYYY-MM-DD" date.
+ */
+bool App::parseDateRange(cxxopts::ParseResult &args, Date &from, Date &to) {
+  if (args.count("from")) {
+    from = Date(args["from"].as<std::string>());
+  }
+  if (args.count("to")) {
+    to = Date(args["to"].as<std::string>());
+  }
+  return args.count("from") || args.count("to");
+}
+
+/**
+ * @brief Prints a sum of expenses for the sum action.
+ *
+ * The exact hundredths are printed as Money::write writes them, but without the
+ * ".0" of whole amounts, so sums below 1,000,000 look as std::cout printed them when
+ * they were doubles ("164", "39.99"). Larger sums now print every digit
+ * ("1234567.89"), where the double was printed to six significant digits ("1.23457e+06").
+ *
+ * @param sum The sum to print.
+ */
+void App::printSum(const Money &sum) {
+  std::string text = sum.str();
+  if (text.size() > 2 && text.compare(text.size() - 2, 2, ".0") == 0) {
+    text.resize(text.size() - 2);
+  }
+  std::cout << text << std::endl;
+}
+
+/**
+ * @brief Prints the statistics of expenses for the stats action.
+ *
+ * One "name: value" line is printed for each of the count, sum, minimum, maximum
+ * and mean, with amounts printed as by printSum. The mean is rounded to the
+ * nearest hundredth. If there are no expenses, only the count and sum are printed.
+ *
+ * @param stats The statistics to print.
+ */
+void App::printStats(const Aggregate &stats) {
+  std::cout << "count: " << stats.count << std::endl;
+  std::cout << "sum: ";
+  printSum(Money::fromUnits(stats.sum));
+  if (stats.count == 0) {
+    return;
+  }
+  const std::int64_t count = static_cast<std::int64_t>(stats.count);
+  std::int64_t mean = stats.sum / count;
+  const std::int64_t remainder = stats.sum % count;
+  if (2 * (remainder < 0 ? -remainder : remainder) >= count) {
+    mean += remainder < 0 ? -1 : 1;
+  }
+  std::cout << "min: ";
+  printSum(Money::fromUnits(stats.min));
+  std::cout << "max: ";
+  printSum(Money::fromUnits(stats.max));
+  std::cout << "mean: ";
+  printSum(Money::fromUnits(mean));
+}
@@ -38,19 +38,45 @@ const std::string STUDENT_NUMBER = "2119504";
 // integer (0-indexed). Or, you can set the value by giving the name followed by
 // = <value> (e.g. CREATE=0).
 //
-// This enum specifies the five different values we support in the action
-// program argument.
-enum Action { CREATE, SUM, JSON, DELETE, UPDATE };
+// This enum specifies the different values we support in the action program
+// argument. COMPACT folds the database's journal back into the database,
+// STATS prints the count, sum, minimum, maximum and mean of the expenses,
+// REPORT prints their counts and sums grouped by month, category and/or tag,
+// TOP prints the largest or most recent of them, and SEARCH prints those whose
+// description contains a query.
+enum Action { CREATE, SUM, JSON, DELETE, UPDATE, COMPACT, STATS, REPORT, TOP, SEARCH };
+
+// The on-disk format of the database: JSON text, or the compact binary
+// snapshot written by ExpenseTracker::saveBinary. Scoped, as JSON is already
+// taken by Action.
+enum class Format { JSON, BINARY };
+
+// The format the report action prints in.
+enum class Output { JSON, CSV };
 
 int run(int argc, char *argv[]);
 
 cxxopts::Options cxxoptsSetup();
 
 App::Action parseActionArgument(cxxopts::ParseResult &args);
+App::Format parseFormatArgument(cxxopts::ParseResult &args, const std::string &db);
+App::Output parseOutputArgument(cxxopts::ParseResult &args);
 
 std::string getJSON(ExpenseTracker &et);
 std::string getJSON(ExpenseTracker &et, const std::string &c);
 std::string getJSON(ExpenseTracker &et, const std::string &c, const std::string &id);
+std::string getJSON(ExpenseTracker &et, const ExpenseTracker::ItemSelector &select);
+std::string getJSON(ExpenseTracker &et, const std::string &c,
+                    const ExpenseTracker::ItemSelector &select);
+
+bool parseDateRange(cxxopts::ParseResult &args, Date &from, Date &to);
+std::vector<const Item *> selectItems(const Category &cObj, const std::string &tag,
+                                      const Date &from, const Date &to);
+std::vector<std::pair<std::string, std::string>> findItems(
+    ExpenseTracker &et, cxxopts::ParseResult &args, const ExpenseTracker::ItemSelector &select);
+
+void printSum(const Money &sum);
+void printStats(const Aggregate &stats);
 
 } // namespace App
 
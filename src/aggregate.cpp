@@ -0,0 +1,197 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "aggregate.h"
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AGGREGATE_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Constructs an empty Aggregate.
+ *
+ * The minimum and maximum start at the largest and smallest possible amounts, so
+ * the first amount added replaces both.
+ */
+Aggregate::Aggregate()
+    : count(0), sum(0), min(std::numeric_limits<std::int64_t>::max()),
+      max(std::numeric_limits<std::int64_t>::min()) {}
+
+/**
+ * @brief Adds one amount to the aggregate.
+ *
+ * @param amount The amount in hundredths.
+ */
+void Aggregate::add(std::int64_t amount) {
+    count++;
+    sum += amount;
+    if (amount < min) {
+        min = amount;
+    }
+    if (amount > max) {
+        max = amount;
+    }
+}
+
+/**
+ * @brief Combines another aggregate into this one.
+ *
+ * @param other The aggregate of another set of amounts.
+ */
+void Aggregate::merge(const Aggregate& other) {
+    count += other.count;
+    sum += other.sum;
+    if (other.min < min) {
+        min = other.min;
+    }
+    if (other.max > max) {
+        max = other.max;
+    }
+}
+
+/**
+ * @brief Aggregates amounts one at a time.
+ *
+ * @param amounts The amounts in hundredths.
+ * @param tags The tag bits of each amount.
+ * @param n The number of amounts.
+ * @param mask The tag bits of which at least one must be set, or 0 to include every amount.
+ * @return Aggregate The count, sum, minimum and maximum of the included amounts.
+ */
+Aggregate aggregateScalar(const std::int64_t* amounts, const std::uint64_t* tags,
+                          std::size_t n, std::uint64_t mask) {
+    Aggregate result;
+    for (std::size_t i = 0; i < n; i++) {
+        if (mask == 0 || (tags[i] & mask) != 0) {
+            result.add(amounts[i]);
+        }
+    }
+    return result;
+}
+
+#ifdef AGGREGATE_AVX2
+
+/**
+ * @brief Aggregates amounts four at a time with AVX2 instructions.
+ *
+ * Each lane keeps its own count, sum, minimum and maximum; amounts that are
+ * filtered out are replaced by values that leave them unchanged. The lanes are
+ * combined at the end and the remaining amounts done one at a time. Must only be
+ * called if hasAvx2() is true.
+ *
+ * @param amounts The amounts in hundredths.
+ * @param tags The tag bits of each amount.
+ * @param n The number of amounts.
+ * @param mask The tag bits of which at least one must be set, or 0 to include every amount.
+ * @return Aggregate The count, sum, minimum and maximum of the included amounts.
+ */
+__attribute__((target("avx2")))
+Aggregate aggregateAvx2(const std::int64_t* amounts, const std::uint64_t* tags,
+                        std::size_t n, std::uint64_t mask) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i highest = _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::max());
+    const __m256i lowest = _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::min());
+    const __m256i tagMask = _mm256_set1_epi64x(static_cast<long long>(mask));
+    __m256i count = zero;
+    __m256i sum = zero;
+    __m256i min = highest;
+    __m256i max = lowest;
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i amount = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(amounts + i));
+        __m256i keep = _mm256_cmpeq_epi64(zero, zero);
+        if (mask != 0) {
+            const __m256i tag = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tags + i));
+            keep = _mm256_xor_si256(_mm256_cmpeq_epi64(_mm256_and_si256(tag, tagMask), zero), keep);
+        }
+        count = _mm256_sub_epi64(count, keep);
+        sum = _mm256_add_epi64(sum, _mm256_and_si256(amount, keep));
+        const __m256i low = _mm256_blendv_epi8(highest, amount, keep);
+        min = _mm256_blendv_epi8(min, low, _mm256_cmpgt_epi64(min, low));
+        const __m256i high = _mm256_blendv_epi8(lowest, amount, keep);
+        max = _mm256_blendv_epi8(max, high, _mm256_cmpgt_epi64(high, max));
+    }
+
+    alignas(32) std::int64_t lanes[4][4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), count);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), sum);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[2]), min);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[3]), max);
+    Aggregate result;
+    for (int lane = 0; lane < 4; lane++) {
+        Aggregate part;
+        part.count = static_cast<std::uint64_t>(lanes[0][lane]);
+        part.sum = lanes[1][lane];
+        part.min = lanes[2][lane];
+        part.max = lanes[3][lane];
+        result.merge(part);
+    }
+    result.merge(aggregateScalar(amounts + i, tags + i, n - i, mask));
+    return result;
+}
+
+/**
+ * @brief Checks whether the CPU supports AVX2 instructions.
+ *
+ * @return true if aggregateAvx2() may be called.
+ */
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#else
+
+/**
+ * @brief Stands in for the AVX2 version on compilers or CPUs without it.
+ *
+ * @param amounts The amounts in hundredths.
+ * @param tags The tag bits of each amount.
+ * @param n The number of amounts.
+ * @param mask The tag bits of which at least one must be set, or 0 to include every amount.
+ * @return Aggregate The result of aggregateScalar().
+ */
+Aggregate aggregateAvx2(const std::int64_t* amounts, const std::uint64_t* tags,
+                        std::size_t n, std::uint64_t mask) {
+    return aggregateScalar(amounts, tags, n, mask);
+}
+
+/**
+ * @brief Checks whether the CPU supports AVX2 instructions.
+ *
+ * @return false, as this build has no AVX2 version.
+ */
+bool hasAvx2() {
+    return false;
+}
+
+#endif
+
+/**
+ * @brief Aggregates amounts with the fastest version the CPU supports.
+ *
+ * Both versions add the amounts exactly, so the result does not depend on which
+ * one is used.
+ *
+ * @param amounts The amounts in hundredths.
+ * @param tags The tag bits of each amount.
+ * @param n The number of amounts.
+ * @param mask The tag bits of which at least one must be set, or 0 to include every amount.
+ * @return Aggregate The count, sum, minimum and maximum of the included amounts.
+ */
+Aggregate aggregate(const std::int64_t* amounts, const std::uint64_t* tags,
+                    std::size_t n, std::uint64_t mask) {
+    if (hasAvx2()) {
+        return aggregateAvx2(amounts, tags, n, mask);
+    }
+    return aggregateScalar(amounts, tags, n, mask);
+}
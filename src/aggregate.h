@@ -0,0 +1,43 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// An Aggregate holds the count, sum, minimum and maximum
+// of a set of amounts. The aggregate functions compute one
+// in a single pass over the amount and tag columns of a
+// Category, with an AVX2 version chosen at runtime on CPUs
+// that support it and a portable scalar version otherwise.
+// -----------------------------------------------------
+
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct Aggregate
+{
+    std::uint64_t count;
+    std::int64_t sum;
+    std::int64_t min;
+    std::int64_t max;
+
+    Aggregate();
+
+    void add(std::int64_t amount);
+    void merge(const Aggregate& other);
+};
+
+Aggregate aggregate(const std::int64_t* amounts, const std::uint64_t* tags,
+                    std::size_t n, std::uint64_t mask);
+Aggregate aggregateScalar(const std::int64_t* amounts, const std::uint64_t* tags,
+                          std::size_t n, std::uint64_t mask);
+Aggregate aggregateAvx2(const std::int64_t* amounts, const std::uint64_t* tags,
+                        std::size_t n, std::uint64_t mask);
+bool hasAvx2();
+
+#endif // AGGREGATE_H
@@ -0,0 +1,80 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "arena.h"
+
+// The first chunk is small so that small categories stay small; later chunks
+// double in size up to the largest.
+static const std::size_t FIRST_CHUNK = 4 * 1024;
+static const std::size_t LARGEST_CHUNK = 1024 * 1024;
+
+/**
+ * @brief Constructs an empty Arena, which allocates no memory until it is first used.
+ */
+Arena::Arena() : chunks(nullptr), next(nullptr), end(nullptr), nextChunkSize(FIRST_CHUNK), reserved(0) {}
+
+/**
+ * @brief Destroys the Arena, freeing all of its memory.
+ */
+Arena::~Arena() {
+    release();
+}
+
+/**
+ * @brief Starts a new chunk large enough for an allocation, and allocates from it.
+ *
+ * @param size The size of the allocation.
+ * @param alignment The alignment of the allocation, a power of two.
+ * @return void* The allocated memory.
+ */
+void* Arena::grow(std::size_t size, std::size_t alignment) {
+    const std::size_t header = (sizeof(Chunk) + alignof(std::max_align_t) - 1) &
+                               ~(alignof(std::max_align_t) - 1);
+    std::size_t chunkSize = nextChunkSize;
+    while (chunkSize < header + size + alignment) {
+        chunkSize *= 2;
+    }
+    if (nextChunkSize < LARGEST_CHUNK) {
+        nextChunkSize *= 2;
+    }
+    Chunk* chunk = static_cast<Chunk*>(::operator new(chunkSize));
+    chunk->previous = chunks;
+    chunk->size = chunkSize;
+    chunks = chunk;
+    reserved += chunkSize;
+    next = reinterpret_cast<char*>(chunk) + header;
+    end = reinterpret_cast<char*>(chunk) + chunkSize;
+    return allocate(size, alignment);
+}
+
+/**
+ * @brief Frees all memory allocated from the Arena, which can then be used again.
+ *
+ * Nothing allocated from the Arena may be used afterwards.
+ */
+void Arena::release() {
+    while (chunks != nullptr) {
+        Chunk* previous = chunks->previous;
+        ::operator delete(chunks);
+        chunks = previous;
+    }
+    next = nullptr;
+    end = nullptr;
+    nextChunkSize = FIRST_CHUNK;
+    reserved = 0;
+}
+
+/**
+ * @brief Returns the memory held by the Arena.
+ *
+ * @return std::size_t The total size of its chunks, in bytes.
+ */
+std::size_t Arena::size() const {
+    return reserved;
+}
@@ -0,0 +1,123 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// An Arena hands out memory from large chunks by moving a
+// pointer along them, and frees it all at once when it is
+// released or destroyed. Freeing single allocations does
+// nothing. Each Category owns an Arena for the map entries
+// and descriptions of its items, so loading a database
+// makes a few large allocations rather than several per
+// item, and a Category is freed chunk by chunk.
+//
+// ArenaAllocator is a standard allocator over an Arena, or
+// over the heap when it has none. Copying a container
+// that uses it gives a copy on the heap, so a copy never
+// refers to the memory of the Arena it was copied from.
+// Moving a container moves its allocator along with its
+// memory, even when move assigning.
+//
+// Build with -DEXPENSES_NO_ARENA to allocate everything
+// from the heap instead, e.g.
+//   CXXFLAGS=-DEXPENSES_NO_ARENA bash build.sh
+// -----------------------------------------------------
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+
+class Arena
+{
+private:
+    struct Chunk
+    {
+        Chunk* previous;
+        std::size_t size;
+    };
+
+    Chunk* chunks;
+    char* next;
+    char* end;
+    std::size_t nextChunkSize;
+    std::size_t reserved;
+
+    void* grow(std::size_t size, std::size_t alignment);
+
+public:
+    Arena();
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Inlined, as it is called for every map entry and description loaded.
+    void* allocate(std::size_t size, std::size_t alignment) {
+        const std::size_t misalignment = reinterpret_cast<std::size_t>(next) & (alignment - 1);
+        const std::size_t padding = misalignment == 0 ? 0 : alignment - misalignment;
+        if (next == nullptr || static_cast<std::size_t>(end - next) < padding + size) {
+            return grow(size, alignment);
+        }
+        void* p = next + padding;
+        next += padding + size;
+        return p;
+    }
+
+    void release();
+    std::size_t size() const;
+};
+
+template <typename T>
+class ArenaAllocator
+{
+private:
+    Arena* arena;
+
+    template <typename> friend class ArenaAllocator;
+
+public:
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::false_type propagate_on_container_swap;
+
+    ArenaAllocator() noexcept : arena(nullptr) {}
+    explicit ArenaAllocator(Arena* arena) noexcept : arena(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    Arena* getArena() const { return arena; }
+
+    T* allocate(std::size_t n) {
+        if (arena == nullptr) {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        if (arena == nullptr) {
+            ::operator delete(p);
+        }
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+    template <typename U> bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+    template <typename U> bool operator!=(const ArenaAllocator<U>& other) const {
+        return arena != other.arena;
+    }
+};
+
+// A string whose characters may be in an Arena.
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>> ArenaString;
+
+#endif // ARENA_H
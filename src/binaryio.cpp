@@ -0,0 +1,177 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "binaryio.h"
+#include <stdexcept>
+
+/**
+ * @brief Constructs an empty BinaryWriter.
+ */
+BinaryWriter::BinaryWriter() {}
+
+/**
+ * @brief Appends a 32-bit unsigned integer in little-endian byte order.
+ *
+ * @param v The value to append.
+ */
+void BinaryWriter::writeU32(std::uint32_t v) {
+    char bytes[4];
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+    buffer.append(bytes, 4);
+}
+
+/**
+ * @brief Appends a 64-bit unsigned integer in little-endian byte order.
+ *
+ * @param v The value to append.
+ */
+void BinaryWriter::writeU64(std::uint64_t v) {
+    char bytes[8];
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+    buffer.append(bytes, 8);
+}
+
+/**
+ * @brief Appends a string as a 32-bit length followed by its bytes.
+ *
+ * @param s The string to append.
+ */
+void BinaryWriter::writeString(std::string_view s) {
+    writeU32(static_cast<std::uint32_t>(s.size()));
+    buffer.append(s.data(), s.size());
+}
+
+/**
+ * @brief Overwrites a previously written 64-bit value, e.g. an offset only known later.
+ *
+ * @param pos The byte position the value was written at.
+ * @param v The new value.
+ * @throws std::out_of_range if the position is outside the written data.
+ */
+void BinaryWriter::patchU64(std::size_t pos, std::uint64_t v) {
+    if (pos + 8 > buffer.size()) {
+        throw std::out_of_range("Patch position out of range");
+    }
+    for (int i = 0; i < 8; i++) {
+        buffer[pos + i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+}
+
+/**
+ * @brief Returns the number of bytes written so far.
+ *
+ * @return std::size_t The size of the written data.
+ */
+std::size_t BinaryWriter::size() const {
+    return buffer.size();
+}
+
+/**
+ * @brief Returns the written data.
+ *
+ * @return const std::string& The encoded bytes.
+ */
+const std::string& BinaryWriter::data() const {
+    return buffer;
+}
+
+/**
+ * @brief Constructs a BinaryReader over a block of encoded bytes.
+ *
+ * The bytes are not copied and must outlive the reader.
+ *
+ * @param data Pointer to the first byte.
+ * @param size Number of bytes available.
+ */
+BinaryReader::BinaryReader(const char* data, std::size_t size)
+    : begin(data), cur(data), end(data + size) {}
+
+/**
+ * @brief Checks that at least n more bytes can be read.
+ *
+ * @param n The number of bytes needed.
+ * @throws std::runtime_error if the data ends too early.
+ */
+void BinaryReader::require(std::size_t n) const {
+    if (static_cast<std::size_t>(end - cur) < n) {
+        throw std::runtime_error("Invalid binary database: unexpected end of data");
+    }
+}
+
+/**
+ * @brief Reads a 32-bit little-endian unsigned integer.
+ *
+ * @return std::uint32_t The value read.
+ * @throws std::runtime_error if the data ends too early.
+ */
+std::uint32_t BinaryReader::readU32() {
+    require(4);
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        v |= static_cast<std::uint32_t>(static_cast<unsigned char>(cur[i])) << (8 * i);
+    }
+    cur += 4;
+    return v;
+}
+
+/**
+ * @brief Reads a 64-bit little-endian unsigned integer.
+ *
+ * @return std::uint64_t The value read.
+ * @throws std::runtime_error if the data ends too early.
+ */
+std::uint64_t BinaryReader::readU64() {
+    require(8);
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v |= static_cast<std::uint64_t>(static_cast<unsigned char>(cur[i])) << (8 * i);
+    }
+    cur += 8;
+    return v;
+}
+
+/**
+ * @brief Reads a length-prefixed string.
+ *
+ * @return std::string The string read.
+ * @throws std::runtime_error if the data ends too early.
+ */
+std::string BinaryReader::readString() {
+    std::uint32_t len = readU32();
+    require(len);
+    std::string s(cur, len);
+    cur += len;
+    return s;
+}
+
+/**
+ * @brief Moves the read position to an absolute byte offset.
+ *
+ * @param pos The offset from the start of the data.
+ * @throws std::runtime_error if the offset is beyond the end of the data.
+ */
+void BinaryReader::seek(std::size_t pos) {
+    if (pos > static_cast<std::size_t>(end - begin)) {
+        throw std::runtime_error("Invalid binary database: offset out of range");
+    }
+    cur = begin + pos;
+}
+
+/**
+ * @brief Returns the current read position.
+ *
+ * @return std::size_t The offset from the start of the data.
+ */
+std::size_t BinaryReader::position() const {
+    return static_cast<std::size_t>(cur - begin);
+}
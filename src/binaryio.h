@@ -0,0 +1,58 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// BinaryWriter and BinaryReader encode and decode the
+// fixed-width little-endian integers and length-prefixed
+// strings that make up the binary database snapshot.
+// -----------------------------------------------------
+
+#ifndef BINARYIO_H
+#define BINARYIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class BinaryWriter
+{
+private:
+    std::string buffer;
+
+public:
+    BinaryWriter();
+
+    void writeU32(std::uint32_t v);
+    void writeU64(std::uint64_t v);
+    void writeString(std::string_view s);
+    void patchU64(std::size_t pos, std::uint64_t v);
+
+    std::size_t size() const;
+    const std::string& data() const;
+};
+
+class BinaryReader
+{
+private:
+    const char* begin;
+    const char* cur;
+    const char* end;
+
+    void require(std::size_t n) const;
+
+public:
+    BinaryReader(const char* data, std::size_t size);
+
+    std::uint32_t readU32();
+    std::uint64_t readU64();
+    std::string readString();
+    void seek(std::size_t pos);
+    std::size_t position() const;
+};
+
+#endif // BINARYIO_H
@@ -8,16 +8,356 @@
 // -----------------------------------------------------
 
 #include "category.h"
+#include "writer.h"
+#include "text.h"
 #include "lib_json.hpp"
-#include <sstream>
-#include <ostream>
+#include <algorithm>
+
+/**
+ * @brief Packs the three lowercased characters at a position in a string into 24 bits.
+ *
+ * @param text The string, at least three characters long from position.
+ * @param i The position of the first character.
+ * @return std::uint32_t The trigram.
+ */
+template <typename String>
+static std::uint32_t trigramAt(const String& text, std::size_t i) {
+    return std::uint32_t(static_cast<unsigned char>(lower(text[i]))) << 16 |
+           std::uint32_t(static_cast<unsigned char>(lower(text[i + 1]))) << 8 |
+           std::uint32_t(static_cast<unsigned char>(lower(text[i + 2])));
+}
+
+/**
+ * @brief Checks whether a string contains a lowercase needle, ignoring case.
+ *
+ * @param text The string to search.
+ * @param needle The lowercase string to find.
+ * @return true if the needle occurs in the text.
+ */
+template <typename String>
+static bool containsIgnoringCase(const String& text, const std::string& needle) {
+    return std::search(text.begin(), text.end(), needle.begin(), needle.end(),
+                       [](char a, char b) { return lower(a) == b; }) != text.end();
+}
+
+/**
+ * @brief Returns the Arena that a new category allocates its items from.
+ *
+ * @param arena The category's Arena.
+ * @return Arena* The Arena, or null if built with EXPENSES_NO_ARENA.
+ */
+static Arena* newItemArena(Arena* arena) {
+#ifdef EXPENSES_NO_ARENA
+    (void)arena;
+    return nullptr;
+#else
+    return arena;
+#endif
+}
 
 /**
  * @brief Constructs a new Category object with the given identifier.
  * 
  * @param id The identifier for the category.
  */
-Category::Category(const std::string& id) : ident(id) {}
+Category::Category(const std::string& id)
+    : ident(id), arena(new Arena()), items(IdentMap<Item>::allocator_type(newItemArena(arena.get()))),
+      total(), columnsValid(false), trigramsValid(false), searches(0), dirty(true) {}
+
+/**
+ * @brief Copy constructor for the Category class.
+ *
+ * The copied items belong to the new category, so that they report their changes to it.
+ *
+ * @param other The Category to copy.
+ */
+Category::Category(const Category& other)
+    : ident(other.ident), arena(new Arena()),
+      items(IdentMap<Item>::allocator_type(newItemArena(arena.get()))), total(other.total),
+      columnsValid(false), trigramsValid(false), searches(0), dirty(other.dirty) {
+    adopt(other);
+}
+
+/**
+ * @brief Move constructor for the Category class.
+ *
+ * Takes the items of the other category, with their Arena and indexes, without copying
+ * any of them: the items stay where they are and belong to the new category. The other
+ * category is left empty.
+ *
+ * @param other The Category to move from.
+ */
+Category::Category(Category&& other) noexcept
+    : ident(std::move(other.ident)), arena(std::move(other.arena)), items(std::move(other.items)),
+      total(other.total), dateColumn(std::move(other.dateColumn)),
+      amountColumn(std::move(other.amountColumn)), tagColumn(std::move(other.tagColumn)),
+      itemColumn(std::move(other.itemColumn)), prefixColumn(std::move(other.prefixColumn)),
+      tagBits(std::move(other.tagBits)), columnsValid(other.columnsValid),
+      byTag(std::move(other.byTag)), trigrams(std::move(other.trigrams)),
+      trigramsValid(other.trigramsValid), searches(other.searches), dirty(other.dirty) {
+    claimItems();
+    other.abandon();
+}
+
+/**
+ * @brief Copy assignment operator for the Category class.
+ *
+ * The items are replaced by copies of the other category's, after the memory of
+ * the old items is released.
+ *
+ * @param other The Category to copy.
+ * @return Category& Reference to this category.
+ */
+Category& Category::operator=(const Category& other) {
+    if (this != &other) {
+        ident = other.ident;
+        byTag.clear();
+        items.clear();
+        if (arena) {
+            arena->release();
+        }
+        total = other.total;
+        trigrams.clear();
+        trigramsValid = false;
+        searches = 0;
+        dirty = true;
+        columnsValid = false;
+        adopt(other);
+    }
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator for the Category class.
+ *
+ * The old items are destroyed and the other category's taken, as by the move constructor.
+ *
+ * @param other The Category to move from.
+ * @return Category& Reference to this category.
+ */
+Category& Category::operator=(Category&& other) {
+    if (this != &other) {
+        ident = std::move(other.ident);
+        // The old items and their tag sets go before the Arena they were allocated from.
+        byTag = std::move(other.byTag);
+        items = std::move(other.items);
+        arena = std::move(other.arena);
+        total = other.total;
+        dateColumn = std::move(other.dateColumn);
+        amountColumn = std::move(other.amountColumn);
+        tagColumn = std::move(other.tagColumn);
+        itemColumn = std::move(other.itemColumn);
+        prefixColumn = std::move(other.prefixColumn);
+        tagBits = std::move(other.tagBits);
+        columnsValid = other.columnsValid;
+        trigrams = std::move(other.trigrams);
+        trigramsValid = other.trigramsValid;
+        searches = other.searches;
+        dirty = true;
+        claimItems();
+        other.abandon();
+    }
+    return *this;
+}
+
+/**
+ * @brief Returns the Arena that the items of this category are allocated from.
+ *
+ * @return Arena* The Arena, or null if they are allocated from the heap.
+ */
+Arena* Category::itemArena() const {
+    return items.get_allocator().getArena();
+}
+
+/**
+ * @brief Copies the items of another category into this one, which becomes their
+ * owner, and indexes their tags.
+ *
+ * @param other The category to copy the items of.
+ */
+void Category::adopt(const Category& other) {
+    for (const auto& pair : other.items) {
+        Item& item = items.insert(std::make_pair(pair.first, Item(pair.second, itemArena())))
+                         .first->second;
+        item.owner = this;
+        indexTags(item);
+    }
+}
+
+/**
+ * @brief Makes this category the owner of its items, after they were moved to it.
+ */
+void Category::claimItems() {
+    for (auto& pair : items) {
+        pair.second.owner = this;
+    }
+}
+
+/**
+ * @brief Empties a category whose items, with their Arena, were moved to another.
+ *
+ * The category stays usable, allocating any items added later from the heap.
+ */
+void Category::abandon() {
+    byTag.clear();
+    items = IdentMap<Item>();
+    total = Money();
+    dateColumn.clear();
+    amountColumn.clear();
+    tagColumn.clear();
+    itemColumn.clear();
+    prefixColumn.clear();
+    tagBits.clear();
+    columnsValid = false;
+    trigrams.clear();
+    trigramsValid = false;
+    searches = 0;
+    dirty = true;
+}
+
+/**
+ * @brief Inserts a new item, which becomes owned by this category, and indexes it.
+ *
+ * @param item The item, whose identifier is not yet in the category.
+ * @return Item& The inserted item.
+ */
+Item& Category::place(Item&& item) {
+    Item& inserted = items.insert(std::make_pair(item.identifier, std::move(item))).first->second;
+    inserted.owner = this;
+    indexTags(inserted);
+    indexDescription(inserted);
+    total += inserted.amount;
+    dirty = true;
+    columnsValid = false;
+    return inserted;
+}
+
+/**
+ * @brief Called by an item of this category whenever it changes.
+ */
+void Category::itemModified() {
+    dirty = true;
+    columnsValid = false;
+}
+
+/**
+ * @brief Called by an item of this category whenever its amount changes, to keep the total up to date.
+ *
+ * @param from The item's amount before the change.
+ * @param to The item's amount after the change.
+ */
+void Category::itemAmountModified(const Money& from, const Money& to) {
+    total -= from;
+    total += to;
+}
+
+/**
+ * @brief Called by an item of this category when a tag is added to it.
+ *
+ * @param item The item.
+ * @param tag The id of the tag added.
+ */
+void Category::itemTagAdded(const Item& item, TagId tag) {
+    auto it = byTag.find(tag);
+    if (it == byTag.end()) {
+        it = byTag.insert(std::make_pair(tag, ItemSet(ItemSet::allocator_type(itemArena())))).first;
+    }
+    it->second.insert(&item);
+}
+
+/**
+ * @brief Called by an item of this category when a tag is deleted from it.
+ *
+ * @param item The item.
+ * @param tag The id of the tag deleted.
+ */
+void Category::itemTagDeleted(const Item& item, TagId tag) {
+    auto it = byTag.find(tag);
+    if (it != byTag.end()) {
+        it->second.erase(&item);
+        if (it->second.empty()) {
+            byTag.erase(it);
+        }
+    }
+}
+
+/**
+ * @brief Adds all tags of an item of this category to the tag index.
+ *
+ * @param item The item.
+ */
+void Category::indexTags(const Item& item) {
+    for (const TagId tag : item.getTagIds()) {
+        itemTagAdded(item, tag);
+    }
+}
+
+/**
+ * @brief Removes all tags of an item of this category from the tag index.
+ *
+ * @param item The item.
+ */
+void Category::unindexTags(const Item& item) {
+    for (const TagId tag : item.getTagIds()) {
+        itemTagDeleted(item, tag);
+    }
+}
+
+/**
+ * @brief Adds the trigrams of the description of an item of this category to the
+ * trigram index, if it has been built.
+ *
+ * @param item The item.
+ */
+void Category::indexDescription(const Item& item) const {
+    if (!trigramsValid) {
+        return;
+    }
+    const ArenaString& text = item.description;
+    for (std::size_t i = 0; i + 3 <= text.size(); i++) {
+        trigrams[trigramAt(text, i)].insert(&item);
+    }
+}
+
+/**
+ * @brief Removes the trigrams of the description of an item of this category from the
+ * trigram index, if it has been built.
+ *
+ * @param item The item.
+ */
+void Category::unindexDescription(const Item& item) const {
+    if (!trigramsValid) {
+        return;
+    }
+    const ArenaString& text = item.description;
+    for (std::size_t i = 0; i + 3 <= text.size(); i++) {
+        auto it = trigrams.find(trigramAt(text, i));
+        if (it != trigrams.end()) {
+            it->second.erase(&item);
+            if (it->second.empty()) {
+                trigrams.erase(it);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reports whether the category changed since it was loaded or last marked clean.
+ *
+ * Adding, replacing or deleting items, and changing any of their data, marks the category dirty.
+ *
+ * @return true if the category has unsaved changes.
+ */
+bool Category::isDirty() const {
+    return dirty;
+}
+
+/**
+ * @brief Marks the category as matching what is stored on disk.
+ */
+void Category::markClean() {
+    dirty = false;
+}
 
 /**
  * @brief Returns the number of items in the category.
@@ -31,9 +371,9 @@ unsigned int Category::size() const {
 /**
  * @brief Gets the identifier of the category.
  * 
- * @return std::string The current category identifier.
+ * @return const std::string& The current category identifier.
  */
-std::string Category::getIdent() const {
+const std::string& Category::getIdent() const {
     return ident;
 }
 
@@ -44,6 +384,7 @@ std::string Category::getIdent() const {
  */
 void Category::setIdent(const std::string& id) {
     ident = id;
+    dirty = true;
 }
 
 /**
@@ -58,20 +399,58 @@ void Category::setIdent(const std::string& id) {
  * @return Item& Reference to the newly inserted or updated item.
  * @throws std::runtime_error If the item cannot be inserted.
  */
-Item& Category::newItem(const std::string& id, const std::string& desc, double amt, const Date& d) {
+Item& Category::newItem(const std::string& id, const std::string& desc, const Money& amt, const Date& d) {
     try {
-        Item newItem(id, desc, amt, d);
-        auto result = items.insert(std::make_pair(id, newItem));
-        if (!result.second) {
-            // If key already exists, overwrite the value
-            result.first->second = newItem;
+        auto it = items.find(id);
+        if (it != items.end()) {
+            // If key already exists, overwrite the value; the item updates the total
+            it->second = Item(id, desc, amt, d, itemArena());
+            dirty = true;
+            columnsValid = false;
+            return it->second;
         }
-        return result.first->second;
+        return place(Item(id, desc, amt, d, itemArena()));
     } catch (...) {
         throw std::runtime_error("Failed to insert item");
     }
 }
 
+/**
+ * @brief Adds a new item to the category or updates an existing one, from a
+ * floating-point amount rounded to the nearest hundredth.
+ *
+ * @param id The identifier for the new or existing item.
+ * @param desc The description for the item.
+ * @param amt The amount, e.g. 2.55.
+ * @param d The date associated with the item.
+ * @return Item& Reference to the newly inserted or updated item.
+ * @throws std::out_of_range if the amount is not finite or too large to hold.
+ * @throws std::runtime_error If the item cannot be inserted.
+ */
+Item& Category::newItem(const std::string& id, const std::string& desc, double amt, const Date& d) {
+    return newItem(id, desc, Money(amt), d);
+}
+
+/**
+ * @brief Adds a new item to the category, made from its fields, unless one with the
+ * same identifier exists.
+ *
+ * The description is copied once, straight into the memory of the category.
+ *
+ * @param id The identifier for the new item.
+ * @param desc The description for the item.
+ * @param amt The amount associated with the item.
+ * @param d The date associated with the item.
+ * @return true if the item was inserted, false if the category already had one with the identifier.
+ */
+bool Category::emplaceItem(const std::string& id, const std::string& desc, const Money& amt, const Date& d) {
+    if (items.find(id) != items.end()) {
+        return false;
+    }
+    place(Item(id, desc, amt, d, itemArena()));
+    return true;
+}
+
 /**
  * @brief Adds an item to the category, merging data if the item already exists.
  * 
@@ -85,8 +464,8 @@ bool Category::addItem(const Item& item) {
     auto it = items.find(item.getIdent());
     if (it != items.end()) {
         // Item already exists, merge tags and update description, amount, and date
-        for (const auto& tag : item.getTags()) {
-            it->second.addTag(tag);
+        for (const TagId tag : item.getTagIds()) {
+            it->second.addTagId(tag);
         }
         it->second.setDescription(item.getDescription());
         it->second.setAmount(item.getAmount());
@@ -94,11 +473,29 @@ bool Category::addItem(const Item& item) {
         return false;
     } else {
         // Item does not exist, insert it
-        items.insert({item.getIdent(), item});
+        place(Item(item, itemArena()));
         return true;
     }
 }
 
+/**
+ * @brief Adds an item to the category, moving it in if it is new.
+ *
+ * As addItem(const Item&), but a new item is moved rather than copied, unless it
+ * belongs to another category or its description is in another category's Arena.
+ *
+ * @param item The item to be added.
+ * @return true if the item was inserted as new, false if the existing item was updated.
+ */
+bool Category::addItem(Item&& item) {
+    if (item.owner != nullptr || !item.canMoveInto(itemArena()) ||
+        items.find(item.identifier) != items.end()) {
+        return addItem(static_cast<const Item&>(item));
+    }
+    place(std::move(item));
+    return true;
+}
+
 /**
  * @brief Retrieves a reference to an item by its identifier.
  * 
@@ -108,7 +505,7 @@ bool Category::addItem(const Item& item) {
  * @return Item& Reference to the found item.
  * @throws std::out_of_range If the item is not found.
  */
-Item& Category::getItem(const std::string& id) {
+Item& Category::getItem(std::string_view id) {
     auto it = items.find(id);
     if (it != items.end()) {
         return it->second;
@@ -126,7 +523,7 @@ Item& Category::getItem(const std::string& id) {
  * @return const Item& Const reference to the found item.
  * @throws std::out_of_range If the item is not found.
  */
-const Item& Category::getItem(const std::string& id) const {
+const Item& Category::getItem(std::string_view id) const {
     auto it = items.find(id);
     if (it != items.end()) {
         return it->second;
@@ -136,14 +533,341 @@ const Item& Category::getItem(const std::string& id) const {
 }
 
 /**
- * @brief Computes the sum of the amounts of all items in the category.
+ * @brief Returns the sum of the amounts of all items in the category.
+ * 
+ * The total is kept up to date as items are added, changed, and deleted, so this
+ * does not visit the items.
+ * 
+ * @return Money The total sum of all item amounts.
+ */
+Money Category::getSum() const {
+    return total;
+}
+
+/**
+ * @brief Computes the sum of the amounts of the items dated between two dates.
+ * 
+ * Uses the date-ordered columns and their running sums, so after the first scan
+ * following a change this takes logarithmic time.
+ * 
+ * @param from The first date included.
+ * @param to The last date included.
+ * @return Money The total sum of the amounts of the items in the range.
+ */
+Money Category::getSum(const Date& from, const Date& to) const {
+    const auto range = findBetween(from, to);
+    return Money::fromUnits(prefixColumn[range.second] - prefixColumn[range.first]);
+}
+
+/**
+ * @brief Retrieves the items dated between two dates.
+ * 
+ * @param from The first date included.
+ * @param to The last date included.
+ * @return std::vector<const Item*> The items in the range, ordered by date.
+ */
+std::vector<const Item*> Category::getItems(const Date& from, const Date& to) const {
+    const auto range = findBetween(from, to);
+    std::vector<const Item*> selection;
+    selection.reserve(range.second - range.first);
+    selection.assign(itemColumn.begin() + range.first, itemColumn.begin() + range.second);
+    return selection;
+}
+
+/**
+ * @brief Computes the sum of the amounts of the items carrying a tag and dated between two dates.
+ * 
+ * Scans the amount and tag columns of the items in the range, see getStats.
+ * 
+ * @param from The first date included.
+ * @param to The last date included.
+ * @param tag The tag.
+ * @return Money The total sum of the amounts of the matching items.
+ */
+Money Category::getSum(const Date& from, const Date& to, std::string_view tag) const {
+    return Money::fromUnits(getStats(from, to, tag).sum);
+}
+
+/**
+ * @brief Retrieves the items carrying a tag and dated between two dates.
+ * 
+ * Scans the tag column of the items in the range. Tags that have no bit in the
+ * columns (beyond the first 64 of the category) are looked up in the tag index.
+ * 
+ * @param from The first date included.
+ * @param to The last date included.
+ * @param tag The tag.
+ * @return std::vector<const Item*> The matching items, ordered by date.
+ */
+std::vector<const Item*> Category::getItems(const Date& from, const Date& to,
+                                            std::string_view tag) const {
+    std::vector<const Item*> selection;
+    std::uint64_t mask;
+    if (!findTagMask(tag, mask)) {
+        for (const Item* item : getItemsWithTag(tag)) {
+            if (!(item->getDate() < from) && !(to < item->getDate())) {
+                selection.push_back(item);
+            }
+        }
+        std::sort(selection.begin(), selection.end(), [](const Item* a, const Item* b) {
+            return a->getDate() < b->getDate();
+        });
+        return selection;
+    }
+    const auto range = findBetween(from, to);
+    for (std::size_t i = range.first; i < range.second; i++) {
+        if (tagColumn[i] & mask) {
+            selection.push_back(itemColumn[i]);
+        }
+    }
+    return selection;
+}
+
+/**
+ * @brief Computes the count, sum, minimum and maximum of the amounts of the items dated between two dates.
+ * 
+ * Scans the amount column of the items in the range in a single pass.
+ * 
+ * @param from The first date included.
+ * @param to The last date included.
+ * @return Aggregate The statistics of the matching items.
+ */
+Aggregate Category::getStats(const Date& from, const Date& to) const {
+    const auto range = findBetween(from, to);
+    return aggregate(amountColumn.data() + range.first, tagColumn.data() + range.first,
+                     range.second - range.first, 0);
+}
+
+/**
+ * @brief Computes the count, sum, minimum and maximum of the amounts of the items dated
+ * between two dates and carrying a tag.
+ * 
+ * Scans the amount and tag columns of the items in the range in a single pass. If the
+ * tag has no bit in the tag column, the matching items are found with the tag index
+ * instead.
+ * 
+ * @param from The first date included.
+ * @param to The last date included.
+ * @param tag The tag.
+ * @return Aggregate The statistics of the matching items.
+ */
+Aggregate Category::getStats(const Date& from, const Date& to, std::string_view tag) const {
+    std::uint64_t mask;
+    if (!findTagMask(tag, mask)) {
+        Aggregate stats;
+        for (const Item* item : getItems(from, to, tag)) {
+            stats.add(item->getAmount().getUnits());
+        }
+        return stats;
+    }
+    if (mask == 0) {
+        return Aggregate();
+    }
+    const auto range = findBetween(from, to);
+    return aggregate(amountColumn.data() + range.first, tagColumn.data() + range.first,
+                     range.second - range.first, mask);
+}
+
+/**
+ * @brief Computes the sum of the amounts of the items carrying a tag.
+ * 
+ * Uses the tag index, so only the matching items are visited.
+ * 
+ * @param tag The tag.
+ * @return Money The total sum of the amounts of the items with the tag.
+ */
+Money Category::getSumForTag(std::string_view tag) const {
+    Money sum;
+    TagId id;
+    auto it = TagDictionary::find(tag, id) ? byTag.find(id) : byTag.end();
+    if (it != byTag.end()) {
+        for (const Item* item : it->second) {
+            sum += item->getAmount();
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Retrieves the items carrying a tag.
+ * 
+ * @param tag The tag.
+ * @return std::vector<const Item*> The items with the tag, in no particular order.
+ */
+std::vector<const Item*> Category::getItemsWithTag(std::string_view tag) const {
+    TagId id;
+    auto it = TagDictionary::find(tag, id) ? byTag.find(id) : byTag.end();
+    if (it == byTag.end()) {
+        return std::vector<const Item*>();
+    }
+    return std::vector<const Item*>(it->second.begin(), it->second.end());
+}
+
+/**
+ * @brief Retrieves the items whose description contains a string, ignoring case.
  * 
- * Iterates through each item in the category and accumulates the total amount.
+ * Once the trigram index is built, queries of three or more characters look up each of
+ * their trigrams in it and only check the items holding the rarest one, so items
+ * sharing no trigram with the query are never visited. Shorter queries, and the first
+ * search of a category, check every item; the second search builds the index.
  * 
- * @return double The total sum of all item amounts.
+ * @param query The string to find.
+ * @return std::vector<const Item*> The matching items, ordered by date and then identifier.
  */
-double Category::getSum() const {
-    double sum = 0.0;
+std::vector<const Item*> Category::search(const std::string& query) const {
+    std::string needle(query);
+    std::transform(needle.begin(), needle.end(), needle.begin(), lower);
+    std::vector<const Item*> matches;
+    if (needle.size() < 3 || (!trigramsValid && searches++ == 0)) {
+        for (const auto& pair : items) {
+            if (containsIgnoringCase(pair.second.description, needle)) {
+                matches.push_back(&pair.second);
+            }
+        }
+    } else {
+        buildTrigrams();
+        const std::set<const Item*>* rarest = nullptr;
+        for (std::size_t i = 0; i + 3 <= needle.size(); i++) {
+            auto it = trigrams.find(trigramAt(needle, i));
+            if (it == trigrams.end()) {
+                return matches;
+            }
+            if (rarest == nullptr || it->second.size() < rarest->size()) {
+                rarest = &it->second;
+            }
+        }
+        for (const Item* item : *rarest) {
+            if (containsIgnoringCase(item->description, needle)) {
+                matches.push_back(item);
+            }
+        }
+    }
+    std::sort(matches.begin(), matches.end(), [](const Item* a, const Item* b) {
+        if (!(a->date == b->date)) {
+            return a->date < b->date;
+        }
+        return a->identifier < b->identifier;
+    });
+    return matches;
+}
+
+/**
+ * @brief Finds the positions in the columns of the items dated between two dates.
+ * 
+ * @param from The first date included.
+ * @param to The last date included.
+ * @return std::pair<std::size_t, std::size_t> The [first, last) positions in the columns.
+ */
+std::pair<std::size_t, std::size_t> Category::findBetween(const Date& from, const Date& to) const {
+    buildColumns();
+    if (to < from) {
+        return std::make_pair(0, 0);
+    }
+    const auto begin = std::lower_bound(dateColumn.begin(), dateColumn.end(), from.getSerial());
+    const auto end = std::upper_bound(begin, dateColumn.end(), to.getSerial());
+    return std::make_pair(static_cast<std::size_t>(begin - dateColumn.begin()),
+                          static_cast<std::size_t>(end - dateColumn.begin()));
+}
+
+/**
+ * @brief Finds the bit standing for a tag in the tag column.
+ * 
+ * @param tag The tag.
+ * @param mask Receives the tag's bit, or 0 if no item of the category carries the tag.
+ * @return true if mask can be used, false if the tag may be carried but has no bit.
+ */
+bool Category::findTagMask(std::string_view tag, std::uint64_t& mask) const {
+    buildColumns();
+    mask = 0;
+    TagId id;
+    if (!TagDictionary::find(tag, id)) {
+        return true;
+    }
+    auto it = tagBits.find(id);
+    if (it != tagBits.end()) {
+        mask = std::uint64_t(1) << it->second;
+        return true;
+    }
+    return tagBits.size() < 64;
+}
+
+/**
+ * @brief Rebuilds the columns if the items changed since they were last built.
+ */
+void Category::buildColumns() const {
+    if (columnsValid) {
+        return;
+    }
+    itemColumn.clear();
+    itemColumn.reserve(items.size());
+    for (const auto& pair : items) {
+        itemColumn.push_back(&pair.second);
+    }
+    std::stable_sort(itemColumn.begin(), itemColumn.end(), [](const Item* a, const Item* b) {
+        return a->getDate() < b->getDate();
+    });
+
+    dateColumn.resize(itemColumn.size());
+    amountColumn.resize(itemColumn.size());
+    tagColumn.resize(itemColumn.size());
+    prefixColumn.resize(itemColumn.size() + 1);
+    prefixColumn[0] = 0;
+    tagBits.clear();
+    for (std::size_t i = 0; i < itemColumn.size(); i++) {
+        const Item* item = itemColumn[i];
+        dateColumn[i] = item->getDate().getSerial();
+        amountColumn[i] = item->getAmount().getUnits();
+        prefixColumn[i + 1] = prefixColumn[i] + amountColumn[i];
+        std::uint64_t bits = 0;
+        for (const TagId tag : item->getTagIds()) {
+            auto it = tagBits.find(tag);
+            if (it == tagBits.end() && tagBits.size() < 64) {
+                it = tagBits.insert(std::make_pair(tag, static_cast<unsigned int>(tagBits.size()))).first;
+            }
+            if (it != tagBits.end()) {
+                bits |= std::uint64_t(1) << it->second;
+            }
+        }
+        tagColumn[i] = bits;
+    }
+    columnsValid = true;
+}
+
+/**
+ * @brief Checks whether the trigram index is built, so that search does not need to
+ * check every item.
+ * 
+ * @return true if the trigram index is built.
+ */
+bool Category::hasSearchIndex() const {
+    return trigramsValid;
+}
+
+/**
+ * @brief Builds the trigram index if it has not been built since the items were copied.
+ */
+void Category::buildTrigrams() const {
+    if (trigramsValid) {
+        return;
+    }
+    trigrams.clear();
+    trigramsValid = true;
+    for (const auto& pair : items) {
+        indexDescription(pair.second);
+    }
+}
+
+/**
+ * @brief Computes the sum of the amounts of all items in the category from scratch.
+ * 
+ * Iterates through each item in the category and accumulates the total amount. Amounts
+ * are held in hundredths, so the result always equals getSum(); tests use it to check
+ * the running total.
+ * 
+ * @return Money The total sum of all item amounts.
+ */
+Money Category::recomputeSum() const {
+    Money sum;
     for (const auto& pair : items) {
         sum += pair.second.getAmount();
     }
@@ -159,10 +883,15 @@ double Category::getSum() const {
  * @return true if the item was successfully found and deleted.
  * @throws std::out_of_range If the item is not found.
  */
-bool Category::deleteItem(const std::string& id) {
+bool Category::deleteItem(std::string_view id) {
     auto it = items.find(id);
     if (it != items.end()) {
+        total -= it->second.getAmount();
+        unindexTags(it->second);
+        unindexDescription(it->second);
         items.erase(it);
+        dirty = true;
+        columnsValid = false;
         return true;
     } else {
         throw std::out_of_range("Item not found");
@@ -184,24 +913,63 @@ bool Category::operator==(const Category& other) const {
 /**
  * @brief Converts the category data into a JSON-formatted string.
  * 
- * Constructs a JSON string where each key is the item identifier and the corresponding value is the 
- * JSON representation of that item, as provided by the item's str() function.
- * 
  * @return std::string The JSON representation of the category.
  */
 std::string Category::str() const {
-    std::ostringstream os;
-    os << "{";
+    StringWriter out;
+    write(out);
+    return out.str();
+}
+
+/**
+ * @brief Writes the category data as JSON.
+ * 
+ * Writes a JSON object where each key is the item identifier and the corresponding value is the 
+ * JSON representation of that item, as written by the item's write() function.
+ * 
+ * @param out The Writer to write to.
+ */
+void Category::write(Writer& out) const {
+    out.put('{');
     size_t count = 0;
     for (const auto& pair : items) {
         if (count > 0) {
-            os << ",";
+            out.put(',');
         }
-        os << "\"" << pair.first << "\":" << pair.second.str();
+        out.put('"');
+        out.write(pair.first);
+        out.write("\":", 2);
+        pair.second.write(out);
         count++;
     }
-    os << "}";
-    return os.str();
+    out.put('}');
+}
+
+/**
+ * @brief Writes some of the items of the category as JSON.
+ * 
+ * Writes the same JSON object as write(Writer&), but with only the selected items, in
+ * order of their identifiers.
+ * 
+ * @param out The Writer to write to.
+ * @param selection Items of this category, in any order.
+ */
+void Category::write(Writer& out, const std::vector<const Item*>& selection) const {
+    std::vector<const Item*> sorted(selection);
+    std::sort(sorted.begin(), sorted.end(), [](const Item* a, const Item* b) {
+        return a->identifier < b->identifier;
+    });
+    out.put('{');
+    for (auto it = sorted.begin(); it != sorted.end(); ++it) {
+        if (it != sorted.begin()) {
+            out.put(',');
+        }
+        out.put('"');
+        out.write((*it)->identifier);
+        out.write("\":", 2);
+        (*it)->write(out);
+    }
+    out.put('}');
 }
 
 /**
@@ -210,8 +978,8 @@ std::string Category::str() const {
  * Provides access to the complete map of items within the category. This is useful for operations 
  * that need to iterate over or inspect all items.
  * 
- * @return const std::map<std::string, Item>& A constant reference to the map of items.
+ * @return const IdentMap<Item>& A constant reference to the map of items.
  */
-const std::map<std::string, Item>& Category::getItems() const {
+const IdentMap<Item>& Category::getItems() const {
     return items;
 }
@@ -13,41 +13,126 @@
 #ifndef CATEGORY_H
 #define CATEGORY_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "aggregate.h"
+#include "containers.h"
 #include "item.h"
 #include <stdexcept>
 
 class Category  
 {
+    friend class Item;
+
 private:
     std::string ident;
-    std::map<std::string, Item> items;
+    // Holds the map entries and descriptions of the items, which are freed
+    // all at once when the category is destroyed or assigned to. Held by
+    // pointer so that it stays put when the category is moved, as the
+    // allocators of items and byTag point to it.
+    std::unique_ptr<Arena> arena;
+    IdentMap<Item> items;
+    // The sum of the amounts of all items, kept up to date as items change.
+    Money total;
+    // A columnar copy of the items ordered by date, for scans: serial days, amounts
+    // in hundredths, a bit per tag (tagBits holds the first 64 tags seen), the item
+    // itself, and the sums of the first 0..n amounts. Rebuilt on the first scan
+    // after the items change.
+    mutable std::vector<std::uint32_t> dateColumn;
+    mutable std::vector<std::int64_t> amountColumn;
+    mutable std::vector<std::uint64_t> tagColumn;
+    mutable std::vector<const Item*> itemColumn;
+    mutable std::vector<std::int64_t> prefixColumn;
+    mutable std::unordered_map<TagId, unsigned int> tagBits;
+    mutable bool columnsValid;
+    // The items carrying each tag, kept up to date as tags are added and deleted.
+    // The sets allocate from the arena, as there is an entry per tag of each item.
+    typedef std::set<const Item*, std::less<const Item*>, ArenaAllocator<const Item*>> ItemSet;
+    std::unordered_map<TagId, ItemSet> byTag;
+    // The items whose lowercased description contains each trigram, packed into 24
+    // bits. Building it costs more than scanning the descriptions once, so it is
+    // built on the second search, then kept up to date as items change. searches
+    // counts the searches made without it.
+    mutable std::unordered_map<std::uint32_t, std::set<const Item*>> trigrams;
+    mutable bool trigramsValid;
+    mutable unsigned int searches;
+    // Whether the category changed since it was loaded or last marked clean.
+    bool dirty;
+
+    Arena* itemArena() const;
+    void adopt(const Category& other);
+    void claimItems();
+    void abandon();
+    Item& place(Item&& item);
+    void itemModified();
+    void itemAmountModified(const Money& from, const Money& to);
+    void itemTagAdded(const Item& item, TagId tag);
+    void itemTagDeleted(const Item& item, TagId tag);
+    void indexTags(const Item& item);
+    void unindexTags(const Item& item);
+    void indexDescription(const Item& item) const;
+    void unindexDescription(const Item& item) const;
+    void buildTrigrams() const;
+    void buildColumns() const;
+    std::pair<std::size_t, std::size_t> findBetween(const Date& from, const Date& to) const;
+    bool findTagMask(std::string_view tag, std::uint64_t& mask) const;
 public:
     Category(const std::string& id);
+    Category(const Category& other);
+    Category(Category&& other) noexcept;
+    Category& operator=(const Category& other);
+    Category& operator=(Category&& other);
 
     unsigned int size() const;
-    std::string getIdent() const;
+    const std::string& getIdent() const;
 
     void setIdent(const std::string& id);
 
+    Item& newItem(const std::string& id, const std::string& desc, const Money& amt, const Date& d);
     Item& newItem(const std::string& id, const std::string& desc, double amt, const Date& d);
 
+    bool emplaceItem(const std::string& id, const std::string& desc, const Money& amt, const Date& d);
+
     bool addItem(const Item& item);
+    bool addItem(Item&& item);
+
+    const Item& getItem(std::string_view id) const;
 
-    const Item& getItem(const std::string& id) const;
+    Item& getItem(std::string_view id);
 
-    Item& getItem(const std::string& id);
+    const IdentMap<Item>& getItems() const;
 
-    const std::map<std::string, Item>& getItems() const;
+    Money getSum() const;
+    Money getSum(const Date& from, const Date& to) const;
+    Money recomputeSum() const;
+    std::vector<const Item*> getItems(const Date& from, const Date& to) const;
+    Money getSum(const Date& from, const Date& to, std::string_view tag) const;
+    std::vector<const Item*> getItems(const Date& from, const Date& to, std::string_view tag) const;
+    Aggregate getStats(const Date& from, const Date& to) const;
+    Aggregate getStats(const Date& from, const Date& to, std::string_view tag) const;
+    Money getSumForTag(std::string_view tag) const;
+    std::vector<const Item*> getItemsWithTag(std::string_view tag) const;
+    std::vector<const Item*> search(const std::string& query) const;
+    bool hasSearchIndex() const;
 
-    double getSum() const;
+    bool deleteItem(std::string_view id);
 
-    bool deleteItem(const std::string& id);
+    bool isDirty() const;
+    void markClean();
 
     bool operator==(const Category& other) const;
 
     std::string str() const;
+    void write(Writer& out) const;
+    void write(Writer& out, const std::vector<const Item*>& selection) const;
 
 
 };
@@ -0,0 +1,531 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Alternatives to std::map for the categories of an
+// ExpenseTracker and the items of a Category, with the
+// parts of its interface that they use:
+//  - FlatMap keeps its entries in a vector sorted by key,
+//    next to a vector of the keys alone for lookups.
+//  - HashMap looks keys up in an open-addressing table
+//    (linear probing), and sorts its entries by key when
+//    they are next iterated over after going out of order.
+// Both iterate in key order, so serialisation does not
+// depend on the container. Values are allocated one by
+// one (with the map's allocator) and never move, as Items
+// are pointed to by their Category's indexes and point
+// back to their Category.
+//
+// IdentMap is the container used for both, allocating
+// from an Arena if given one: std::map by default, FlatMap if built with -DEXPENSES_FLAT_MAP, or
+// HashMap if built with -DEXPENSES_HASH_MAP, e.g.
+//   CXXFLAGS=-DEXPENSES_FLAT_MAP bash build.sh
+// Its comparator and hash are transparent, so identifiers
+// can be looked up as a std::string_view without a copy.
+// -----------------------------------------------------
+
+#ifndef CONTAINERS_H
+#define CONTAINERS_H
+
+#include "arena.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// An iterator over a vector of pointers to entries, giving the entries.
+template <typename Value, typename Entry>
+class BoxIterator
+{
+private:
+    Entry* const* box;
+
+    template <typename, typename> friend class BoxIterator;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    BoxIterator() : box(nullptr) {}
+    explicit BoxIterator(Entry* const* box) : box(box) {}
+    template <typename Other, typename = typename std::enable_if<
+                                  std::is_convertible<Other*, Value*>::value>::type>
+    BoxIterator(const BoxIterator<Other, Entry>& other) : box(other.box) {}
+
+    Entry* const* base() const { return box; }
+
+    Value& operator*() const { return **box; }
+    Value* operator->() const { return *box; }
+    BoxIterator& operator++() { ++box; return *this; }
+    BoxIterator operator++(int) { BoxIterator old(*this); ++box; return old; }
+    BoxIterator& operator--() { --box; return *this; }
+    BoxIterator operator--(int) { BoxIterator old(*this); --box; return old; }
+    BoxIterator operator+(difference_type n) const { return BoxIterator(box + n); }
+    difference_type operator-(const BoxIterator& other) const { return box - other.box; }
+    bool operator==(const BoxIterator& other) const { return box == other.box; }
+    bool operator!=(const BoxIterator& other) const { return box != other.box; }
+};
+
+// The entries of FlatMap and HashMap, each in its own allocation, and what the
+// two share: allocation, copying, iteration and size. As for std::map, a copy
+// gets the allocator given by select_on_container_copy_construction, and
+// assignment keeps the allocator of the map assigned to. Moving takes the
+// entries and the allocator, which the allocators used here allow even when
+// move assigning; the map moved from is left empty.
+template <typename Key, typename T, typename Alloc>
+class BoxedEntries
+{
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef Alloc allocator_type;
+    typedef BoxIterator<value_type, value_type> iterator;
+    typedef BoxIterator<const value_type, value_type> const_iterator;
+
+protected:
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<value_type> EntryAlloc;
+    typedef std::allocator_traits<EntryAlloc> EntryTraits;
+
+    EntryAlloc alloc;
+    mutable std::vector<value_type*> entries;
+
+    explicit BoxedEntries(const Alloc& alloc) : alloc(alloc) {}
+    BoxedEntries(const BoxedEntries& other)
+        : alloc(EntryTraits::select_on_container_copy_construction(other.alloc)) {
+        copyFrom(other);
+    }
+    BoxedEntries(BoxedEntries&& other) noexcept
+        : alloc(other.alloc), entries(std::move(other.entries)) {
+        other.entries.clear();
+    }
+    BoxedEntries& operator=(const BoxedEntries& other) {
+        if (this != &other) {
+            destroyAll();
+            copyFrom(other);
+        }
+        return *this;
+    }
+    BoxedEntries& operator=(BoxedEntries&& other) noexcept {
+        if (this != &other) {
+            destroyAll();
+            alloc = other.alloc;
+            entries.swap(other.entries);
+        }
+        return *this;
+    }
+    ~BoxedEntries() { destroyAll(); }
+
+    template <typename... Args> value_type* make(Args&&... args) {
+        value_type* entry = EntryTraits::allocate(alloc, 1);
+        try {
+            EntryTraits::construct(alloc, entry, std::forward<Args>(args)...);
+        } catch (...) {
+            EntryTraits::deallocate(alloc, entry, 1);
+            throw;
+        }
+        return entry;
+    }
+
+    void destroy(value_type* entry) {
+        EntryTraits::destroy(alloc, entry);
+        EntryTraits::deallocate(alloc, entry, 1);
+    }
+
+    void destroyAll() {
+        for (value_type* entry : entries) {
+            destroy(entry);
+        }
+        entries.clear();
+    }
+
+    // Subclasses copy whatever else they hold about the entries themselves.
+    void copyFrom(const BoxedEntries& other) {
+        entries.reserve(other.entries.size());
+        for (const value_type* entry : other.entries) {
+            entries.push_back(make(*entry));
+        }
+    }
+
+    iterator at(std::size_t i) const { return iterator(entries.data() + i); }
+    std::size_t indexOf(const_iterator it) const {
+        return static_cast<std::size_t>(it.base() - entries.data());
+    }
+
+public:
+    std::size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    allocator_type get_allocator() const { return allocator_type(alloc); }
+};
+
+// A map held in a vector sorted by key. Lookups binary search the keys, which
+// are held in a vector of their own so that the search does not follow a
+// pointer per step. Inserting a key larger than every other, as when loading a
+// database written in key order, appends; other inserts and erases shift the
+// entries after them.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<std::pair<const Key, T>>>
+class FlatMap : public BoxedEntries<Key, T, Alloc>
+{
+public:
+    typedef BoxedEntries<Key, T, Alloc> Base;
+    typedef typename Base::value_type value_type;
+    typedef typename Base::iterator iterator;
+    typedef typename Base::const_iterator const_iterator;
+
+private:
+    std::vector<Key> keys;
+    Compare less;
+
+    template <typename K> std::size_t lowerBound(const K& key) const {
+        return static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), key, less) -
+                                        keys.begin());
+    }
+
+public:
+    explicit FlatMap(const Alloc& alloc = Alloc()) : Base(alloc) {}
+    FlatMap(const FlatMap& other) : Base(other), keys(other.keys) {}
+    FlatMap(FlatMap&& other) noexcept : Base(std::move(other)), keys(std::move(other.keys)) {
+        other.keys.clear();
+    }
+    FlatMap& operator=(const FlatMap& other) {
+        if (this != &other) {
+            Base::operator=(other);
+            keys = other.keys;
+        }
+        return *this;
+    }
+    FlatMap& operator=(FlatMap&& other) noexcept {
+        if (this != &other) {
+            Base::operator=(std::move(other));
+            keys.swap(other.keys);
+            other.keys.clear();
+        }
+        return *this;
+    }
+
+    iterator begin() { return this->at(0); }
+    iterator end() { return this->at(keys.size()); }
+    const_iterator begin() const { return this->at(0); }
+    const_iterator end() const { return this->at(keys.size()); }
+
+    // K is Key, or anything Compare compares with it.
+    template <typename K> iterator find(const K& key) {
+        const std::size_t i = lowerBound(key);
+        return this->at(i < keys.size() && !less(key, keys[i]) ? i : keys.size());
+    }
+    template <typename K> const_iterator find(const K& key) const {
+        const std::size_t i = lowerBound(key);
+        return this->at(i < keys.size() && !less(key, keys[i]) ? i : keys.size());
+    }
+    template <typename K> std::size_t count(const K& key) const { return find(key) != end() ? 1 : 0; }
+
+    std::pair<iterator, bool> insert(value_type value) {
+        std::size_t i = keys.size();
+        if (!keys.empty() && !less(keys.back(), value.first)) {
+            i = lowerBound(value.first);
+            if (!less(value.first, keys[i])) {
+                return std::make_pair(this->at(i), false);
+            }
+        }
+        keys.insert(keys.begin() + i, value.first);
+        try {
+            this->entries.reserve(this->entries.size() + 1);
+            this->entries.insert(this->entries.begin() + i, this->make(std::move(value)));
+        } catch (...) {
+            keys.erase(keys.begin() + i);
+            throw;
+        }
+        return std::make_pair(this->at(i), true);
+    }
+
+    iterator erase(const_iterator it) {
+        const std::size_t i = this->indexOf(it);
+        this->destroy(this->entries[i]);
+        this->entries.erase(this->entries.begin() + i);
+        keys.erase(keys.begin() + i);
+        return this->at(i);
+    }
+    std::size_t erase(const Key& key) {
+        const_iterator it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    void clear() {
+        this->destroyAll();
+        keys.clear();
+    }
+
+    bool operator==(const FlatMap& other) const {
+        return keys == other.keys &&
+               std::equal(begin(), end(), other.begin(),
+                          [](const value_type& a, const value_type& b) { return a.second == b.second; });
+    }
+    bool operator!=(const FlatMap& other) const { return !(*this == other); }
+};
+
+// A map that looks keys up in an open-addressing hash table with linear probing.
+// Each slot holds the position of an entry plus one (0 for an empty slot) and the
+// top bits of its hash, so most probes compare no keys. The table is at most half
+// full, and erasing shifts later entries of the probe sequence back rather than
+// leaving tombstones.
+//
+// Inserting appends and erasing moves the last entry into the gap, so the entries
+// go out of key order; the next begin() sorts them and rebuilds the table.
+// Iterating a const HashMap therefore writes to it, so a HashMap must not be
+// iterated from several threads at once (different HashMaps may be).
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<std::pair<const Key, T>>>
+class HashMap : public BoxedEntries<Key, T, Alloc>
+{
+public:
+    typedef BoxedEntries<Key, T, Alloc> Base;
+    typedef typename Base::value_type value_type;
+    typedef typename Base::iterator iterator;
+    typedef typename Base::const_iterator const_iterator;
+
+private:
+    struct Slot
+    {
+        std::uint32_t entry;
+        std::uint32_t tag;
+    };
+
+    mutable std::vector<Slot> slots;
+    mutable std::vector<std::size_t> hashes;
+    mutable bool sorted;
+    Hash hasher;
+    Compare less;
+
+    static std::uint32_t tagOf(std::size_t hash) {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(hash) >> 32) |
+               static_cast<std::uint32_t>(hash);
+    }
+
+    std::size_t mix(std::size_t hash) const {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> 7);
+    }
+
+    // Finds the slot of a key, or the empty slot where it would go.
+    template <typename K> std::size_t probe(const K& key, std::size_t hash) const {
+        const std::size_t mask = slots.size() - 1;
+        const std::uint32_t tag = tagOf(hash);
+        for (std::size_t s = mix(hash) & mask;; s = (s + 1) & mask) {
+            const Slot& slot = slots[s];
+            if (slot.entry == 0 ||
+                (slot.tag == tag && this->entries[slot.entry - 1]->first == key)) {
+                return s;
+            }
+        }
+    }
+
+    void place(std::size_t entry) const {
+        const std::size_t mask = slots.size() - 1;
+        std::size_t s = mix(hashes[entry]) & mask;
+        while (slots[s].entry != 0) {
+            s = (s + 1) & mask;
+        }
+        slots[s].entry = static_cast<std::uint32_t>(entry + 1);
+        slots[s].tag = tagOf(hashes[entry]);
+    }
+
+    void rebuild(std::size_t capacity) const {
+        slots.assign(capacity, Slot{0, 0});
+        for (std::size_t i = 0; i < this->entries.size(); i++) {
+            place(i);
+        }
+    }
+
+    void sort() const {
+        if (sorted) {
+            return;
+        }
+        std::vector<std::size_t> order(this->entries.size());
+        for (std::size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+            return less(this->entries[a]->first, this->entries[b]->first);
+        });
+        std::vector<value_type*> sortedEntries(order.size());
+        std::vector<std::size_t> sortedHashes(order.size());
+        for (std::size_t i = 0; i < order.size(); i++) {
+            sortedEntries[i] = this->entries[order[i]];
+            sortedHashes[i] = hashes[order[i]];
+        }
+        this->entries.swap(sortedEntries);
+        hashes.swap(sortedHashes);
+        rebuild(slots.size());
+        sorted = true;
+    }
+
+    // Empties a slot, moving later entries of its probe sequence back into the gap.
+    void unplace(std::size_t s) {
+        const std::size_t mask = slots.size() - 1;
+        std::size_t gap = s;
+        for (std::size_t next = (s + 1) & mask; slots[next].entry != 0; next = (next + 1) & mask) {
+            const std::size_t home = mix(hashes[slots[next].entry - 1]) & mask;
+            if (((next - home) & mask) >= ((next - gap) & mask)) {
+                slots[gap] = slots[next];
+                gap = next;
+            }
+        }
+        slots[gap] = Slot{0, 0};
+    }
+
+public:
+    explicit HashMap(const Alloc& alloc = Alloc()) : Base(alloc), slots(16, Slot{0, 0}), sorted(true) {}
+    HashMap(const HashMap& other)
+        : Base(other), slots(other.slots), hashes(other.hashes), sorted(other.sorted) {}
+    HashMap(HashMap&& other)
+        : Base(std::move(other)), slots(std::move(other.slots)), hashes(std::move(other.hashes)),
+          sorted(other.sorted) {
+        other.clear();
+    }
+    HashMap& operator=(const HashMap& other) {
+        if (this != &other) {
+            Base::operator=(other);
+            slots = other.slots;
+            hashes = other.hashes;
+            sorted = other.sorted;
+        }
+        return *this;
+    }
+    HashMap& operator=(HashMap&& other) {
+        if (this != &other) {
+            Base::operator=(std::move(other));
+            slots.swap(other.slots);
+            hashes.swap(other.hashes);
+            sorted = other.sorted;
+            other.clear();
+        }
+        return *this;
+    }
+
+    // begin() sorts the entries if they are out of order, which invalidates the
+    // iterators found since the last change; end() is the same either way.
+    iterator begin() { sort(); return this->at(0); }
+    iterator end() { return this->at(this->entries.size()); }
+    const_iterator begin() const { sort(); return this->at(0); }
+    const_iterator end() const { return this->at(this->entries.size()); }
+
+    // K is Key, or anything Hash hashes as it would the equal Key.
+    template <typename K> iterator find(const K& key) {
+        const std::size_t s = probe(key, hasher(key));
+        return this->at(slots[s].entry == 0 ? this->entries.size() : slots[s].entry - 1);
+    }
+    template <typename K> const_iterator find(const K& key) const {
+        const std::size_t s = probe(key, hasher(key));
+        return this->at(slots[s].entry == 0 ? this->entries.size() : slots[s].entry - 1);
+    }
+    template <typename K> std::size_t count(const K& key) const {
+        return slots[probe(key, hasher(key))].entry != 0 ? 1 : 0;
+    }
+
+    std::pair<iterator, bool> insert(value_type value) {
+        const std::size_t hash = hasher(value.first);
+        std::size_t s = probe(value.first, hash);
+        if (slots[s].entry != 0) {
+            return std::make_pair(this->at(slots[s].entry - 1), false);
+        }
+        if (sorted && !this->entries.empty() && !less(this->entries.back()->first, value.first)) {
+            sorted = false;
+        }
+        this->entries.reserve(this->entries.size() + 1);
+        hashes.reserve(hashes.size() + 1);
+        this->entries.push_back(this->make(std::move(value)));
+        hashes.push_back(hash);
+        if (this->entries.size() * 2 > slots.size()) {
+            rebuild(slots.size() * 2);
+        } else {
+            slots[s] = Slot{static_cast<std::uint32_t>(this->entries.size()), tagOf(hash)};
+        }
+        return std::make_pair(this->at(this->entries.size() - 1), true);
+    }
+
+    iterator erase(const_iterator it) {
+        const std::size_t i = this->indexOf(it);
+        unplace(probe(this->entries[i]->first, hashes[i]));
+        this->destroy(this->entries[i]);
+        const std::size_t last = this->entries.size() - 1;
+        if (i != last) {
+            const std::size_t s = probe(this->entries[last]->first, hashes[last]);
+            this->entries[i] = this->entries[last];
+            hashes[i] = hashes[last];
+            slots[s].entry = static_cast<std::uint32_t>(i + 1);
+            sorted = false;
+        }
+        this->entries.pop_back();
+        hashes.pop_back();
+        return this->at(i);
+    }
+    std::size_t erase(const Key& key) {
+        const_iterator it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    void clear() {
+        this->destroyAll();
+        hashes.clear();
+        slots.assign(16, Slot{0, 0});
+        sorted = true;
+    }
+
+    bool operator==(const HashMap& other) const {
+        return this->size() == other.size() &&
+               std::equal(begin(), end(), other.begin(), [](const value_type& a, const value_type& b) {
+                   return a.first == b.first && a.second == b.second;
+               });
+    }
+    bool operator!=(const HashMap& other) const { return !(*this == other); }
+};
+
+// Hashes a std::string and its std::string_view alike.
+struct IdentHash
+{
+    typedef void is_transparent;
+
+    std::size_t operator()(std::string_view ident) const {
+        return std::hash<std::string_view>()(ident);
+    }
+};
+
+#if defined(EXPENSES_FLAT_MAP)
+template <typename T>
+using IdentMap = FlatMap<std::string, T, std::less<>,
+                         ArenaAllocator<std::pair<const std::string, T>>>;
+#elif defined(EXPENSES_HASH_MAP)
+template <typename T>
+using IdentMap = HashMap<std::string, T, IdentHash, std::less<>,
+                         ArenaAllocator<std::pair<const std::string, T>>>;
+#else
+template <typename T>
+using IdentMap = std::map<std::string, T, std::less<>,
+                          ArenaAllocator<std::pair<const std::string, T>>>;
+#endif
+
+#endif // CONTAINERS_H
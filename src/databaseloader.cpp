@@ -0,0 +1,439 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "databaseloader.h"
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief Constructs a DatabaseLoader that populates a single Category.
+ *
+ * The JSON input is the object holding the category's items, i.e. one of the
+ * values of the top-level database object in the format documented on
+ * ExpenseTracker::load, so parsing starts at depth 1: depth 2 holds items,
+ * depth 3 holds item fields and depth 4 is the tags array of an item.
+ *
+ * @param c The Category that parsed items are added to.
+ */
+DatabaseLoader::DatabaseLoader(Category& c)
+    : category(&c), depth(1), skip(0), amount(), hasAmount(false), hasDescription(false),
+      hasDate(false) {}
+
+/**
+ * @brief Skips JSON whitespace.
+ *
+ * @param p The current position.
+ * @param end The end of the input.
+ * @return const char* The first non-whitespace position, or end.
+ */
+static const char* skipWhitespace(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief Skips a JSON string, including escaped quotes inside it.
+ *
+ * @param p The position of the opening quote.
+ * @param end The end of the input.
+ * @return const char* The position just past the closing quote.
+ * @throws std::runtime_error if the string is not terminated.
+ */
+static const char* skipString(const char* p, const char* end) {
+    for (p++; p < end; p++) {
+        if (*p == '\\') {
+            p++;
+        } else if (*p == '"') {
+            return p + 1;
+        }
+    }
+    throw std::runtime_error("Invalid database: unterminated string");
+}
+
+/**
+ * @brief Finds the byte range of every category in a JSON database without parsing the items.
+ *
+ * Only strings and brackets are looked at, which is far cheaper than parsing. The
+ * contents of each range are checked when the category is later parsed with a
+ * DatabaseLoader constructed from that Category. If a category appears more than once,
+ * the last occurrence is used, as when parsing into a JSON DOM.
+ *
+ * @param data The database contents.
+ * @param size The size of the contents in bytes.
+ * @param ranges Receives the [begin, end) offsets of each category's object, keyed by category identifier.
+ * @throws std::runtime_error if the top-level structure is not a JSON object of objects, or
+ * anything but whitespace follows it.
+ */
+void DatabaseLoader::index(const char* data, std::size_t size,
+                           std::map<std::string, std::pair<std::size_t, std::size_t>>& ranges) {
+    const char* end = data + size;
+    const char* p = skipWhitespace(data, end);
+    if (p == end || *p != '{') {
+        throw std::runtime_error("Invalid database: expected an object");
+    }
+    p = skipWhitespace(p + 1, end);
+    if (p < end && *p == '}') {
+        p = skipWhitespace(p + 1, end);
+        if (p != end) {
+            throw std::runtime_error("Invalid database: unexpected content after the object");
+        }
+        return;
+    }
+    while (true) {
+        if (p == end || *p != '"') {
+            throw std::runtime_error("Invalid database: expected a category identifier");
+        }
+        const char* keyEnd = skipString(p, end);
+        std::string key(p + 1, keyEnd - 1);
+        if (key.find('\\') != std::string::npos) {
+            key = nlohmann::json::parse(p, keyEnd).get<std::string>();
+        }
+
+        p = skipWhitespace(keyEnd, end);
+        if (p == end || *p != ':') {
+            throw std::runtime_error("Invalid database: expected ':'");
+        }
+        p = skipWhitespace(p + 1, end);
+        if (p == end || *p != '{') {
+            throw std::runtime_error("Invalid database: expected an object for " + key);
+        }
+
+        const char* begin = p;
+        unsigned int nesting = 0;
+        do {
+            if (*p == '"') {
+                p = skipString(p, end);
+                continue;
+            }
+            if (*p == '{' || *p == '[') {
+                nesting++;
+            } else if (*p == '}' || *p == ']') {
+                nesting--;
+            }
+            p++;
+        } while (nesting > 0 && p < end);
+        if (nesting > 0) {
+            throw std::runtime_error("Invalid database: unterminated object for " + key);
+        }
+        ranges[key] = std::make_pair(static_cast<std::size_t>(begin - data),
+                                     static_cast<std::size_t>(p - data));
+
+        p = skipWhitespace(p, end);
+        if (p < end && *p == ',') {
+            p = skipWhitespace(p + 1, end);
+        } else if (p < end && *p == '}') {
+            p = skipWhitespace(p + 1, end);
+            if (p != end) {
+                throw std::runtime_error("Invalid database: unexpected content after the object");
+            }
+            return;
+        } else {
+            throw std::runtime_error("Invalid database: expected ',' or '}'");
+        }
+    }
+}
+
+/**
+ * @brief Checks whether the value being read belongs to an item field the loader does not know.
+ *
+ * Such values are ignored so that databases with extra fields still load.
+ *
+ * @return true if the current value is an unknown item field.
+ */
+bool DatabaseLoader::unknownField() const {
+    return depth == 3 && field != "amount" && field != "date" &&
+           field != "description" && field != "tags";
+}
+
+/**
+ * @brief Handles a numeric value read by the parser.
+ *
+ * Numbers are only meaningful as the "amount" field of an item. Unknown item
+ * fields are ignored, anything else is rejected. The amount is parsed from the
+ * number's text rather than from a double, so that it is exact.
+ *
+ * @param text The text of the number read.
+ * @return true to continue parsing.
+ * @throws std::runtime_error if the number appears where it is not allowed.
+ * @throws std::invalid_argument if the amount has digits beyond the hundredths.
+ * @throws std::out_of_range if the amount is too large.
+ */
+bool DatabaseLoader::numberValue(const std::string& text) {
+    if (skip > 0) {
+        return true;
+    }
+    if (depth == 3 && field == "amount") {
+        amount = Money::parse(text);
+        hasAmount = true;
+        return true;
+    }
+    if (unknownField()) {
+        return true;
+    }
+    throw std::runtime_error("Invalid database: unexpected number");
+}
+
+/**
+ * @brief Handles a string value read by the parser.
+ *
+ * Strings are the "date" and "description" fields of an item, or entries of its
+ * "tags" array. The parser allows the passed string to be moved from.
+ *
+ * @param str The value read.
+ * @return true to continue parsing.
+ * @throws std::runtime_error if the string appears where it is not allowed.
+ */
+bool DatabaseLoader::value(std::string& str) {
+    if (skip > 0) {
+        return true;
+    }
+    if (depth == 4) {
+        auto it = tagIds.find(str);
+        if (it == tagIds.end()) {
+            const TagId id = TagDictionary::intern(str);
+            it = tagIds.insert(std::make_pair(std::move(str), id)).first;
+        }
+        tags.push_back(it->second);
+        return true;
+    }
+    if (depth == 3) {
+        if (field == "date") {
+            date = std::move(str);
+            hasDate = true;
+        } else if (field == "description") {
+            description = std::move(str);
+            hasDescription = true;
+        } else if (field == "amount" || field == "tags") {
+            throw std::runtime_error("Invalid database: unexpected string for " + field);
+        }
+        return true;
+    }
+    throw std::runtime_error("Invalid database: unexpected string");
+}
+
+/**
+ * @brief Creates the item that has just been read in the current category.
+ *
+ * @throws std::runtime_error if the item has no amount, description or date.
+ * @throws std::invalid_argument if the item's date is invalid.
+ */
+void DatabaseLoader::finishItem() {
+    if (!hasAmount || !hasDescription || !hasDate) {
+        throw std::runtime_error("Invalid database: item " + itemKey + " has no " +
+                                 (!hasAmount ? "amount" : !hasDescription ? "description" : "date"));
+    }
+    Item& item = category->newItem(itemKey, description, amount, Date(date));
+    for (const TagId tag : tags) {
+        item.addTagId(tag);
+    }
+}
+
+/**
+ * @brief Handles a null value; only allowed for unknown fields or an empty "tags" field.
+ *
+ * @return true to continue parsing.
+ * @throws std::runtime_error if the null appears where it is not allowed.
+ */
+bool DatabaseLoader::null() {
+    if (skip > 0 || unknownField() || (depth == 3 && field == "tags")) {
+        return true;
+    }
+    throw std::runtime_error("Invalid database: unexpected null");
+}
+
+/**
+ * @brief Handles a boolean value; only allowed for unknown fields.
+ *
+ * @return true to continue parsing.
+ * @throws std::runtime_error if the boolean appears where it is not allowed.
+ */
+bool DatabaseLoader::boolean(bool) {
+    if (skip > 0 || unknownField()) {
+        return true;
+    }
+    throw std::runtime_error("Invalid database: unexpected boolean");
+}
+
+/**
+ * @brief Handles a signed integer value, forwarding it as an amount.
+ *
+ * @param val The value read.
+ * @return true to continue parsing.
+ */
+bool DatabaseLoader::number_integer(number_integer_t val) {
+    return numberValue(std::to_string(val));
+}
+
+/**
+ * @brief Handles an unsigned integer value, forwarding it as an amount.
+ *
+ * @param val The value read.
+ * @return true to continue parsing.
+ */
+bool DatabaseLoader::number_unsigned(number_unsigned_t val) {
+    return numberValue(std::to_string(val));
+}
+
+/**
+ * @brief Handles a floating-point value, forwarding its text as an amount.
+ *
+ * @param s The text of the number.
+ * @return true to continue parsing.
+ */
+bool DatabaseLoader::number_float(number_float_t, const string_t& s) {
+    return numberValue(s);
+}
+
+/**
+ * @brief Handles a string value.
+ *
+ * @param val The value read.
+ * @return true to continue parsing.
+ */
+bool DatabaseLoader::string(string_t& val) {
+    return value(val);
+}
+
+/**
+ * @brief Rejects binary values, which cannot occur in a JSON database.
+ *
+ * @throws std::runtime_error always.
+ */
+bool DatabaseLoader::binary(binary_t&) {
+    throw std::runtime_error("Invalid database: unexpected binary value");
+}
+
+/**
+ * @brief Handles the start of a JSON object.
+ *
+ * Opening an item object resets the fields collected for the next item.
+ *
+ * @return true to continue parsing.
+ * @throws std::runtime_error if the object appears where it is not allowed.
+ */
+bool DatabaseLoader::start_object(std::size_t) {
+    if (skip > 0) {
+        skip++;
+        return true;
+    }
+    switch (depth) {
+        case 1:
+            break;
+        case 2:
+            description.clear();
+            date.clear();
+            amount = Money();
+            tags.clear();
+            field.clear();
+            hasAmount = false;
+            hasDescription = false;
+            hasDate = false;
+            break;
+        case 3:
+            if (!unknownField()) {
+                throw std::runtime_error("Invalid database: unexpected object for " + field);
+            }
+            skip = 1;
+            return true;
+        default:
+            throw std::runtime_error("Invalid database: unexpected object in tags");
+    }
+    depth++;
+    return true;
+}
+
+/**
+ * @brief Handles an object key.
+ *
+ * Depending on the depth, the key is an item identifier or the name of an item field.
+ *
+ * @param val The key read.
+ * @return true to continue parsing.
+ */
+bool DatabaseLoader::key(string_t& val) {
+    if (skip > 0) {
+        return true;
+    }
+    if (depth == 2) {
+        itemKey = std::move(val);
+    } else {
+        field = std::move(val);
+    }
+    return true;
+}
+
+/**
+ * @brief Handles the end of a JSON object, adding a finished item to its category.
+ *
+ * @return true to continue parsing.
+ */
+bool DatabaseLoader::end_object() {
+    if (skip > 0) {
+        skip--;
+        return true;
+    }
+    if (depth == 3) {
+        finishItem();
+    }
+    depth--;
+    return true;
+}
+
+/**
+ * @brief Handles the start of a JSON array.
+ *
+ * Only the "tags" field of an item may hold an array; arrays in unknown item
+ * fields are skipped.
+ *
+ * @return true to continue parsing.
+ * @throws std::runtime_error if the array appears where it is not allowed.
+ */
+bool DatabaseLoader::start_array(std::size_t) {
+    if (skip > 0) {
+        skip++;
+        return true;
+    }
+    if (depth == 3 && field == "tags") {
+        depth++;
+        return true;
+    }
+    if (unknownField()) {
+        skip = 1;
+        return true;
+    }
+    throw std::runtime_error("Invalid database: unexpected array");
+}
+
+/**
+ * @brief Handles the end of a JSON array.
+ *
+ * @return true to continue parsing.
+ */
+bool DatabaseLoader::end_array() {
+    if (skip > 0) {
+        skip--;
+        return true;
+    }
+    depth--;
+    return true;
+}
+
+/**
+ * @brief Reports a syntax error in the JSON input.
+ *
+ * @param ex The exception describing the error.
+ * @return never returns normally.
+ * @throws std::runtime_error carrying the parser's error message.
+ */
+bool DatabaseLoader::parse_error(std::size_t, const std::string&,
+                                 const nlohmann::detail::exception& ex) {
+    throw std::runtime_error(ex.what());
+}
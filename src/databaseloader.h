@@ -0,0 +1,81 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// A DatabaseLoader receives the events of nlohmann::json's
+// SAX parser and builds the Items of a Category directly,
+// without first materialising a JSON DOM. It can also index
+// where each category is in a database without parsing its
+// items, so that each can be parsed on its own.
+// -----------------------------------------------------
+
+#ifndef DATABASELOADER_H
+#define DATABASELOADER_H
+
+#include "expensetracker.h"
+#include "lib_json.hpp"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DatabaseLoader : public nlohmann::json_sax<nlohmann::json>
+{
+private:
+    Category* category;
+
+    // Nesting level of the object/array currently being read, and how many
+    // levels of an unknown value are being skipped.
+    unsigned int depth;
+    unsigned int skip;
+
+    // Fields of the item currently being read.
+    std::string itemKey;
+    std::string field;
+    std::string description;
+    std::string date;
+    Money amount;
+    std::vector<TagId> tags;
+    // Whether the fields that every item needs have been read.
+    bool hasAmount;
+    bool hasDescription;
+    bool hasDate;
+    // The ids of the tags seen so far, so that most tags are interned without
+    // taking the TagDictionary's lock.
+    std::unordered_map<std::string, TagId> tagIds;
+
+    bool unknownField() const;
+    bool numberValue(const std::string& text);
+    bool value(std::string& str);
+    void finishItem();
+
+public:
+    DatabaseLoader(Category& c);
+
+    static void index(const char* data, std::size_t size,
+                      std::map<std::string, std::pair<std::size_t, std::size_t>>& ranges);
+
+    bool null() override;
+    bool boolean(bool val) override;
+    bool number_integer(number_integer_t val) override;
+    bool number_unsigned(number_unsigned_t val) override;
+    bool number_float(number_float_t val, const string_t& s) override;
+    bool string(string_t& val) override;
+    bool binary(binary_t& val) override;
+    bool start_object(std::size_t elements) override;
+    bool key(string_t& val) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position,
+                     const std::string& last_token,
+                     const nlohmann::detail::exception& ex) override;
+};
+
+#endif // DATABASELOADER_H
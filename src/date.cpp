@@ -8,25 +8,24 @@
 // -----------------------------------------------------
 
 #include "date.h"
+#include "writer.h"
 #include "lib_json.hpp"
 
 #include <ctime>
-#include <sstream>
-#include <ostream>
-#include <iomanip>
+
+// The largest year accepted, so that every valid date's serial day fits in 32 bits.
+static const unsigned int MAX_YEAR = 9999999;
 
 /**
  * @brief Default constructor that initializes the date to the current system date.
  *
  * Uses the C standard library to obtain the current time and sets the
- * year, month, and day accordingly.
+ * date accordingly.
  */
 Date::Date() {
     time_t t = time(0);
     struct tm* now = localtime(&t);
-    year = now->tm_year + 1900;
-    month = now->tm_mon + 1;
-    day = now->tm_mday;
+    serial = toSerial(now->tm_year + 1900, now->tm_mon + 1, now->tm_mday);
 }
 
 /**
@@ -43,16 +42,14 @@ Date::Date(unsigned int y, unsigned int m, unsigned int d) {
     if (!isValidDate(y, m, d)) {
         throw std::invalid_argument("Invalid date");
     }
-    year = y;
-    month = m;
-    day = d;
+    serial = toSerial(y, m, d);
 }
 
 /**
  * @brief Constructs a Date object from a string in the format "YYYY-MM-DD".
  *
- * Parses the string to extract year, month, and day components, validates the date,
- * and initializes the Date object. Throws an exception if the format or values are invalid.
+ * The ten characters are read directly: every position other than the two dashes
+ * must be a decimal digit. The date is then validated.
  *
  * @param dateString A string representing the date in "YYYY-MM-DD" format.
  * @throws std::invalid_argument if the date format is incorrect or the date is invalid.
@@ -61,30 +58,93 @@ Date::Date(const std::string& dateString) {
     if (dateString.length() != 10 || dateString[4] != '-' || dateString[7] != '-') {
         throw std::invalid_argument("Invalid date format");
     }
-    try {
-        year = std::stoi(dateString.substr(0, 4));
-        month = std::stoi(dateString.substr(5, 2));
-        day = std::stoi(dateString.substr(8, 2));
-        if (!isValidDate(year, month, day)) {
-            throw std::invalid_argument("Invalid date");
-        }
-    } catch (const std::exception&) {
+    const char* s = dateString.data();
+    unsigned int digits[8] = {
+        static_cast<unsigned int>(s[0] - '0'), static_cast<unsigned int>(s[1] - '0'),
+        static_cast<unsigned int>(s[2] - '0'), static_cast<unsigned int>(s[3] - '0'),
+        static_cast<unsigned int>(s[5] - '0'), static_cast<unsigned int>(s[6] - '0'),
+        static_cast<unsigned int>(s[8] - '0'), static_cast<unsigned int>(s[9] - '0')};
+    bool bad = false;
+    for (unsigned int digit : digits) {
+        bad |= digit > 9;
+    }
+    if (bad) {
         throw std::invalid_argument("Invalid date format");
     }
+    const unsigned int y = digits[0] * 1000 + digits[1] * 100 + digits[2] * 10 + digits[3];
+    const unsigned int m = digits[4] * 10 + digits[5];
+    const unsigned int d = digits[6] * 10 + digits[7];
+    if (!isValidDate(y, m, d)) {
+        throw std::invalid_argument("Invalid date format");
+    }
+    serial = toSerial(y, m, d);
 }
 
 /**
- * @brief Returns the date as a string in "YYYY-MM-DD" format.
+ * @brief Returns the earliest valid date, 0001-01-01.
  *
- * Uses string stream formatting to ensure that year, month, and day are zero-padded as needed.
+ * @return Date The earliest date.
+ */
+Date Date::earliest() {
+    return Date(1, 1, 1);
+}
+
+/**
+ * @brief Returns the latest valid date, the last day of the largest year accepted.
+ *
+ * @return Date The latest date.
+ */
+Date Date::latest() {
+    return Date(MAX_YEAR, 12, 31);
+}
+
+/**
+ * @brief Returns the date with the given number of days since 0001-01-01.
+ *
+ * @param serial The serial day, as returned by getSerial.
+ * @return Date The date.
+ * @throws std::invalid_argument if the serial day is after the latest valid date.
+ */
+Date Date::fromSerial(std::uint32_t serial) {
+    if (serial > latest().serial) {
+        throw std::invalid_argument("Invalid date");
+    }
+    Date date = earliest();
+    date.serial = serial;
+    return date;
+}
+
+/**
+ * @brief Returns the date as a string in "YYYY-MM-DD" format.
  *
  * @return std::string The formatted date string.
  */
 std::string Date::str() const {
-    std::ostringstream os;
-    os << std::setfill('0') << std::setw(4) << year << '-'
-       << std::setw(2) << month << '-' << std::setw(2) << day;
-    return os.str();
+    StringWriter out;
+    write(out);
+    return out.str();
+}
+
+/**
+ * @brief Writes the date in "YYYY-MM-DD" format.
+ *
+ * The year, month, and day are zero-padded to four, two, and two digits.
+ *
+ * @param out The Writer to write to.
+ */
+void Date::write(Writer& out) const {
+    unsigned int year, month, day;
+    civil(year, month, day);
+    if (year > 9999) {
+        out.write(std::to_string(year));
+    } else {
+        const char text[4] = {static_cast<char>('0' + year / 1000), static_cast<char>('0' + year / 100 % 10),
+                              static_cast<char>('0' + year / 10 % 10), static_cast<char>('0' + year % 10)};
+        out.write(text, sizeof(text));
+    }
+    const char text[6] = {'-', static_cast<char>('0' + month / 10), static_cast<char>('0' + month % 10),
+                          '-', static_cast<char>('0' + day / 10), static_cast<char>('0' + day % 10)};
+    out.write(text, sizeof(text));
 }
 
 /**
@@ -102,9 +162,7 @@ void Date::setDate(unsigned int y, unsigned int m, unsigned int d) {
     if (!isValidDate(y, m, d)) {
         throw std::invalid_argument("Invalid date");
     }
-    year = y;
-    month = m;
-    day = d;
+    serial = toSerial(y, m, d);
 }
 
 /**
@@ -113,7 +171,9 @@ void Date::setDate(unsigned int y, unsigned int m, unsigned int d) {
  * @return unsigned int The year value.
  */
 unsigned int Date::getYear() const {
-    return year;
+    unsigned int y, m, d;
+    civil(y, m, d);
+    return y;
 }
 
 /**
@@ -122,7 +182,9 @@ unsigned int Date::getYear() const {
  * @return unsigned int The month value.
  */
 unsigned int Date::getMonth() const {
-    return month;
+    unsigned int y, m, d;
+    civil(y, m, d);
+    return m;
 }
 
 /**
@@ -131,41 +193,89 @@ unsigned int Date::getMonth() const {
  * @return unsigned int The day value.
  */
 unsigned int Date::getDay() const {
-    return day;
+    unsigned int y, m, d;
+    civil(y, m, d);
+    return d;
+}
+
+/**
+ * @brief Gets the number of days since 0001-01-01, which orders dates like operator<.
+ *
+ * @return std::uint32_t The serial day.
+ */
+std::uint32_t Date::getSerial() const {
+    return serial;
 }
 
 /**
  * @brief Compares this Date object with another for equality.
  *
- * Two Date objects are equal if their year, month, and day values match.
+ * Two Date objects are equal if they are the same day.
  *
  * @param other The Date object to compare against.
  * @return true if both dates are equal, false otherwise.
  */
 bool Date::operator==(const Date& other) const {
-    return year == other.year && month == other.month && day == other.day;
+    return serial == other.serial;
 }
 
 /**
  * @brief Compares this Date object with another to determine if it precedes the other.
  *
- * Comparison is done lexicographically: first by year, then month, and finally day.
+ * Serial days increase with the date, so this is a single integer comparison.
  *
  * @param other The Date object to compare against.
  * @return true if this date is earlier than the other, false otherwise.
  */
 bool Date::operator<(const Date& other) const {
-    if (year < other.year) return true;
-    if (year > other.year) return false;
-    if (month < other.month) return true;
-    if (month > other.month) return false;
-    return day < other.day;
+    return serial < other.serial;
+}
+
+/**
+ * @brief Converts the serial day back into a year, month, and day.
+ *
+ * Years are counted from March so that the leap day falls at the end of the year;
+ * see Howard Hinnant's civil_from_days algorithm.
+ *
+ * @param y Receives the year.
+ * @param m Receives the month.
+ * @param d Receives the day.
+ */
+void Date::civil(unsigned int& y, unsigned int& m, unsigned int& d) const {
+    const std::uint64_t days = static_cast<std::uint64_t>(serial) + 306; // since 0000-03-01
+    const std::uint64_t era = days / 146097;
+    const std::uint64_t dayOfEra = days - era * 146097;
+    const std::uint64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const std::uint64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const std::uint64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    d = static_cast<unsigned int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    m = static_cast<unsigned int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+    y = static_cast<unsigned int>(yearOfEra + era * 400 + (m <= 2 ? 1 : 0));
+}
+
+/**
+ * @brief Converts a valid year, month, and day into the number of days since 0001-01-01.
+ *
+ * The inverse of civil(); see Howard Hinnant's days_from_civil algorithm.
+ *
+ * @param y Year component.
+ * @param m Month component.
+ * @param d Day component.
+ * @return std::uint32_t The serial day.
+ */
+std::uint32_t Date::toSerial(unsigned int y, unsigned int m, unsigned int d) {
+    const std::uint64_t year = y - (m <= 2 ? 1 : 0);
+    const std::uint64_t era = year / 400;
+    const std::uint64_t yearOfEra = year - era * 400;
+    const std::uint64_t dayOfYear = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const std::uint64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return static_cast<std::uint32_t>(era * 146097 + dayOfEra - 306);
 }
 
 /**
  * @brief Validates whether the provided year, month, and day form a valid date.
  *
- * Checks for valid ranges in year, month, and day, and ensures that the day value
+ * Checks for valid ranges in year (up to 9999999), month, and day, and ensures that the day value
  * does not exceed the maximum days allowed for the given month.
  *
  * @param y Year component.
@@ -174,7 +284,7 @@ bool Date::operator<(const Date& other) const {
  * @return true if the date is valid, false otherwise.
  */
 bool Date::isValidDate(unsigned int y, unsigned int m, unsigned int d) {
-    if (y < 1 || m < 1 || m > 12 || d < 1) return false;
+    if (y < 1 || y > MAX_YEAR || m < 1 || m > 12 || d < 1) return false;
     unsigned int daysInMonth = getDaysInMonth(y, m);
     return d <= daysInMonth;
 }
@@ -7,25 +7,27 @@
 // Canvas: https://canvas.swansea.ac.uk/courses/52781
 // -----------------------------------------------------
 // An Date class that contains the following member variables
-// - year
-// - month
-// - day
+// - serial (the number of days since 0001-01-01)
 // -----------------------------------------------------
 
 #ifndef DATE_H
 #define DATE_H
 
+#include <cstdint>
 #include <string>
 #include <stdexcept>
 
+class Writer;
+
 class Date
 {
 private:
-   unsigned int year;
-   unsigned int month;
-   unsigned int day;
+   std::uint32_t serial;
+
+   void civil(unsigned int& y, unsigned int& m, unsigned int& d) const;
 
-   // Private static helper functions for date validation
+   // Private static helper functions for date validation and conversion
+   static std::uint32_t toSerial(unsigned int y, unsigned int m, unsigned int d);
    static bool isValidDate(unsigned int y, unsigned int m, unsigned int d);
    static unsigned int getDaysInMonth(unsigned int y, unsigned int m);
    static bool isLeapYear(unsigned int y);
@@ -34,12 +36,18 @@ public:
     Date(unsigned int y, unsigned int m, unsigned int d);      
     Date(const std::string& dateString);
 
+    static Date earliest();
+    static Date latest();
+    static Date fromSerial(std::uint32_t serial);
+
     void setDate(unsigned int y, unsigned int m, unsigned int d);
     unsigned int getYear() const;
     unsigned int getMonth() const;
     unsigned int getDay() const;
+    std::uint32_t getSerial() const;
     
     std::string str() const;
+    void write(Writer& out) const;
 
     bool operator==(const Date& other) const;
     bool operator<(const Date& other) const;
@@ -7,25 +7,205 @@
 // Canvas: https://canvas.swansea.ac.uk/courses/52781
 // -----------------------------------------------------
 #include "expensetracker.h"
+#include "binaryio.h"
+#include "databaseloader.h"
+#include "journal.h"
+#include "mappedfile.h"
+#include "threadpool.h"
+#include "writer.h"
 #include "lib_json.hpp"
+#include <cstdio>
+#include <exception>
 #include <fstream>
-#include <sstream>
+#include <set>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+
+// First bytes ("371E") and format version of a binary database snapshot.
+static const std::uint32_t BINARY_MAGIC = 0x45313733;
+static const std::uint32_t BINARY_VERSION = 3;
+
+/**
+ * @brief Moves a fully written temporary file over the file it replaces.
+ *
+ * Saves write to a temporary file first, so a failed save leaves the old file intact, and a
+ * lazily opened database that is still mapped keeps its old contents while it is being overwritten.
+ *
+ * @param temp The path of the temporary file.
+ * @param filename The path of the file to replace.
+ * @throws std::runtime_error if the file cannot be replaced.
+ */
+static void replaceFile(const std::string& temp, const std::string& filename) {
+    if (std::rename(temp.c_str(), filename.c_str()) != 0) {
+        // Some platforms cannot rename over an existing file.
+        std::remove(filename.c_str());
+        if (std::rename(temp.c_str(), filename.c_str()) != 0) {
+            std::remove(temp.c_str());
+            throw std::runtime_error("Failed to write file: " + filename);
+        }
+    }
+}
 
 /**
  * @brief Default constructor for ExpenseTracker.
  *
  * Initializes an empty ExpenseTracker object.
  */
-ExpenseTracker::ExpenseTracker() {}
+ExpenseTracker::ExpenseTracker() : changed(false) {}
 
 /**
  * @brief Returns the number of categories in the ExpenseTracker.
  *
+ * Categories that have not been parsed yet are counted as well.
+ *
  * @return unsigned int The count of categories stored.
  */
 unsigned int ExpenseTracker::size() const {
-    return categories.size();
+    return categories.size() + unloaded.size();
+}
+
+/**
+ * @brief Parses the JSON of one category from a byte range of a database.
+ *
+ * @param c The Category that the parsed items are added to.
+ * @param data The database contents.
+ * @param range The [begin, end) offsets of the category's object.
+ * @throws std::runtime_error if the category's JSON is invalid.
+ */
+static void parseCategory(Category& c, const char* data,
+                          const std::pair<std::size_t, std::size_t>& range) {
+    DatabaseLoader loader(c);
+    nlohmann::json::sax_parse(data + range.first, data + range.second, &loader);
+}
+
+/**
+ * @brief Parses a category that was indexed by open but not parsed yet.
+ *
+ * Does nothing if the category has already been parsed or does not exist. The
+ * parsed category starts out clean, and its byte range is kept so that save can
+ * copy it unchanged for as long as it stays clean.
+ *
+ * @param id The identifier of the category.
+ * @throws std::runtime_error if the category's JSON is invalid.
+ */
+void ExpenseTracker::materialise(std::string_view id) const {
+    auto it = unloaded.find(id);
+    if (it == unloaded.end()) {
+        return;
+    }
+    auto result = categories.insert(std::make_pair(it->first, Category(it->first)));
+    try {
+        parseCategory(result.first->second, source->data(), it->second);
+    } catch (...) {
+        categories.erase(result.first);
+        throw;
+    }
+    result.first->second.markClean();
+    segments.insert(*it);
+    unloaded.erase(it);
+}
+
+/**
+ * @brief Parses every category that was indexed by open but not parsed yet.
+ *
+ * With more than one thread, the categories are parsed in parallel, each into its
+ * own Category. The outcome is the same as parsing them one by one in order: if a
+ * category is invalid, the categories before it are parsed, it and the ones after
+ * it are left unparsed, and its error is thrown.
+ *
+ * @throws std::runtime_error if a category's JSON is invalid.
+ */
+void ExpenseTracker::materialiseAll() const {
+    if (!pool || unloaded.size() < 2) {
+        while (!unloaded.empty()) {
+            materialise(unloaded.begin()->first);
+        }
+        return;
+    }
+
+    // Categories keep their address as others are inserted, but not every
+    // container keeps its iterators valid, so keep pointers.
+    std::vector<Category*> parsed;
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    for (const auto& pair : unloaded) {
+        parsed.push_back(&categories.insert(std::make_pair(pair.first, Category(pair.first))).first->second);
+        ranges.push_back(pair.second);
+    }
+    std::vector<std::exception_ptr> errors(parsed.size());
+    const char* data = source->data();
+    pool->run(parsed.size(), [&](std::size_t i) {
+        try {
+            parseCategory(*parsed[i], data, ranges[i]);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+
+    for (std::size_t i = 0; i < parsed.size(); i++) {
+        if (errors[i]) {
+            for (std::size_t j = i; j < parsed.size(); j++) {
+                categories.erase(categories.find(parsed[j]->getIdent()));
+            }
+            std::rethrow_exception(errors[i]);
+        }
+        parsed[i]->markClean();
+        segments.insert(*unloaded.begin());
+        unloaded.erase(unloaded.begin());
+    }
+}
+
+/**
+ * @brief Runs a task on every category, in parallel if more than one thread is set.
+ *
+ * Parses any categories not parsed yet first. The task is given each category with
+ * its position in identifier order, so that it can store a partial result that
+ * the caller then combines in that order, giving the same result as a serial loop.
+ *
+ * @param task The task, called with the position of a category and the category.
+ * @throws std::runtime_error if a category's JSON is invalid.
+ */
+void ExpenseTracker::forEachCategory(
+        const std::function<void(std::size_t, const Category&)>& task) const {
+    materialiseAll();
+    std::vector<const Category*> order;
+    order.reserve(categories.size());
+    for (const auto& pair : categories) {
+        order.push_back(&pair.second);
+    }
+    if (pool && order.size() > 1) {
+        pool->run(order.size(), [&](std::size_t i) { task(i, *order[i]); });
+    } else {
+        for (std::size_t i = 0; i < order.size(); i++) {
+            task(i, *order[i]);
+        }
+    }
+}
+
+/**
+ * @brief Sets the number of threads that work on categories in parallel.
+ *
+ * Copies of this ExpenseTracker made afterwards share its threads.
+ *
+ * @param threads The number of threads, 0 for one per hardware thread, or 1 to work serially.
+ */
+void ExpenseTracker::setThreads(unsigned int threads) {
+    pool.reset();
+    if (threads != 1) {
+        pool = std::make_shared<ThreadPool>(threads);
+        if (pool->size() == 1) {
+            pool.reset();
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of threads that work on categories in parallel.
+ *
+ * @return unsigned int The number of threads, 1 if work is done serially.
+ */
+unsigned int ExpenseTracker::getThreads() const {
+    return pool ? pool->size() : 1;
 }
 
 /**
@@ -39,6 +219,7 @@ unsigned int ExpenseTracker::size() const {
  * @throws std::runtime_error if the Category cannot be inserted.
  */
 Category& ExpenseTracker::newCategory(const std::string& id) {
+    materialise(id);
     auto it = categories.find(id);
     if (it != categories.end()) {
         // If category already exists, return the existing one
@@ -49,6 +230,7 @@ Category& ExpenseTracker::newCategory(const std::string& id) {
         if (!result.second) {
             throw std::runtime_error("Failed to insert category");
         }
+        changed = true;
         return result.first->second;
     }
 }
@@ -65,6 +247,7 @@ Category& ExpenseTracker::newCategory(const std::string& id) {
  * @throws std::runtime_error if the Category cannot be inserted.
  */
 bool ExpenseTracker::addCategory(const Category& category) {
+    materialise(category.getIdent());
     auto it = categories.find(category.getIdent());
     if (it != categories.end()) {
         // Merge items from the incoming category with the existing one
@@ -74,6 +257,33 @@ bool ExpenseTracker::addCategory(const Category& category) {
         return false;
     } else {
         categories.insert(std::make_pair(category.getIdent(), category));
+        changed = true;
+        return true;
+    }
+}
+
+/**
+ * @brief Adds a Category object to the ExpenseTracker, moving it in if it is new.
+ *
+ * As addCategory(const Category&), but a new category is moved rather than copied, so
+ * its items stay where they are. The category moved from is left empty.
+ *
+ * @param category The Category object to add.
+ * @return true if the category was inserted as new, false if merged.
+ */
+bool ExpenseTracker::addCategory(Category&& category) {
+    materialise(category.getIdent());
+    auto it = categories.find(category.getIdent());
+    if (it != categories.end()) {
+        // Merge items from the incoming category with the existing one
+        for (const auto& pair : category.getItems()) {
+            it->second.addItem(pair.second);
+        }
+        return false;
+    } else {
+        const std::string id = category.getIdent();
+        categories.insert(std::make_pair(id, std::move(category)));
+        changed = true;
         return true;
     }
 }
@@ -87,7 +297,8 @@ bool ExpenseTracker::addCategory(const Category& category) {
  * @return const Category& A constant reference to the found Category.
  * @throws std::out_of_range if no Category with the specified identifier exists.
  */
-const Category& ExpenseTracker::getCategory(const std::string& id) const {
+const Category& ExpenseTracker::getCategory(std::string_view id) const {
+    materialise(id);
     auto it = categories.find(id);
     if (it != categories.end()) {
         return it->second;
@@ -105,7 +316,8 @@ const Category& ExpenseTracker::getCategory(const std::string& id) const {
  * @return Category& A mutable reference to the found Category.
  * @throws std::out_of_range if no Category with the specified identifier exists.
  */
-Category& ExpenseTracker::getCategory(const std::string& id) {
+Category& ExpenseTracker::getCategory(std::string_view id) {
+    materialise(id);
     auto it = categories.find(id);
     if (it != categories.end()) {
         return it->second;
@@ -123,36 +335,312 @@ Category& ExpenseTracker::getCategory(const std::string& id) {
  * @return true if the Category was successfully deleted.
  * @throws std::out_of_range if no Category with the specified identifier exists.
  */
-bool ExpenseTracker::deleteCategory(const std::string& id) {
+bool ExpenseTracker::deleteCategory(std::string_view id) {
+    auto segment = segments.find(id);
+    if (segment != segments.end()) {
+        segments.erase(segment);
+    }
+    auto u = unloaded.find(id);
+    if (u != unloaded.end()) {
+        unloaded.erase(u);
+        changed = true;
+        return true;
+    }
     auto it = categories.find(id);
     if (it != categories.end()) {
         categories.erase(it);
+        changed = true;
         return true;
     } else {
         throw std::out_of_range("Category not found");
     }
 }
 
+/**
+ * @brief Reports whether the ExpenseTracker has changed since it was loaded.
+ *
+ * Adding or deleting categories, and any change to a Category or its Items, counts.
+ *
+ * @return true if there are changes that have not been saved.
+ */
+bool ExpenseTracker::isDirty() const {
+    if (changed) {
+        return true;
+    }
+    for (const auto& pair : categories) {
+        if (pair.second.isDirty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Finds the categories with changes, before more are loaded into them.
+ *
+ * @return std::set<std::string, std::less<>> The identifiers of the dirty categories.
+ */
+std::set<std::string, std::less<>> ExpenseTracker::dirtyCategories() const {
+    std::set<std::string, std::less<>> dirty;
+    for (const auto& pair : categories) {
+        if (pair.second.isDirty()) {
+            dirty.insert(pair.first);
+        }
+    }
+    return dirty;
+}
+
+/**
+ * @brief Marks what was just loaded as clean, keeping the changes made before.
+ *
+ * A category that items were loaded into no longer matches its byte range in a
+ * lazily opened database, so its range is forgotten and save serializes it again.
+ *
+ * @param dirty The categories that were dirty before loading, from dirtyCategories.
+ * @param wasChanged Whether categories had been added or deleted before loading.
+ */
+void ExpenseTracker::markLoaded(const std::set<std::string, std::less<>>& dirty, bool wasChanged) {
+    for (auto& pair : categories) {
+        if (pair.second.isDirty()) {
+            auto segment = segments.find(pair.first);
+            if (segment != segments.end()) {
+                segments.erase(segment);
+            }
+            if (dirty.count(pair.first) == 0) {
+                pair.second.markClean();
+            }
+        }
+    }
+    changed = wasChanged;
+}
+
 /**
  * @brief Computes the total sum of all expenses across all categories.
  *
- * Iterates over each Category in the ExpenseTracker and sums the expense amounts of all items.
+ * Adds up the running total of each Category, so the cost depends on the number of
+ * categories rather than the number of items.
  *
- * @return double The total sum of all expense amounts.
+ * @return Money The total sum of all expense amounts.
  */
-double ExpenseTracker::getSum() const {
-    double sum = 0.0;
+Money ExpenseTracker::getSum() const {
+    materialiseAll();
+    Money sum;
     for (const auto& pair : categories) {
         sum += pair.second.getSum();
     }
     return sum;
 }
 
+/**
+ * @brief Computes the sum of all expenses dated between two dates, across all categories.
+ *
+ * Each Category answers from its date index, so this takes logarithmic time per category.
+ *
+ * @param from The first date included.
+ * @param to The last date included.
+ * @return Money The total sum of the amounts of the expenses in the range.
+ */
+Money ExpenseTracker::getSum(const Date& from, const Date& to) const {
+    std::vector<Money> parts(size());
+    forEachCategory([&](std::size_t i, const Category& c) { parts[i] = c.getSum(from, to); });
+    Money sum;
+    for (const Money& part : parts) {
+        sum += part;
+    }
+    return sum;
+}
+
+/**
+ * @brief Computes the sum of all expenses carrying a tag and dated between two dates.
+ *
+ * @param from The first date included.
+ * @param to The last date included.
+ * @param tag The tag.
+ * @return Money The total sum of the amounts of the matching expenses.
+ */
+Money ExpenseTracker::getSum(const Date& from, const Date& to, const std::string& tag) const {
+    std::vector<Money> parts(size());
+    forEachCategory([&](std::size_t i, const Category& c) { parts[i] = c.getSum(from, to, tag); });
+    Money sum;
+    for (const Money& part : parts) {
+        sum += part;
+    }
+    return sum;
+}
+
+/**
+ * @brief Computes the count, sum, minimum and maximum of all expenses dated between two dates.
+ *
+ * Each Category scans its own columns, in parallel if more than one thread is set, and
+ * the results are combined in category order.
+ *
+ * @param from The first date included.
+ * @param to The last date included.
+ * @return Aggregate The statistics of the matching expenses.
+ */
+Aggregate ExpenseTracker::getStats(const Date& from, const Date& to) const {
+    std::vector<Aggregate> parts(size());
+    forEachCategory([&](std::size_t i, const Category& c) { parts[i] = c.getStats(from, to); });
+    Aggregate stats;
+    for (const Aggregate& part : parts) {
+        stats.merge(part);
+    }
+    return stats;
+}
+
+/**
+ * @brief Computes the count, sum, minimum and maximum of all expenses carrying a tag and
+ * dated between two dates.
+ *
+ * @param from The first date included.
+ * @param to The last date included.
+ * @param tag The tag.
+ * @return Aggregate The statistics of the matching expenses.
+ */
+Aggregate ExpenseTracker::getStats(const Date& from, const Date& to, const std::string& tag) const {
+    std::vector<Aggregate> parts(size());
+    forEachCategory([&](std::size_t i, const Category& c) { parts[i] = c.getStats(from, to, tag); });
+    Aggregate stats;
+    for (const Aggregate& part : parts) {
+        stats.merge(part);
+    }
+    return stats;
+}
+
+/**
+ * @brief Computes the sum of the chosen expenses across all categories.
+ *
+ * The selector may be called from several threads at once, for different categories.
+ *
+ * @param select Chooses the items of each category to include.
+ * @return Money The total sum of the amounts of the chosen expenses.
+ */
+Money ExpenseTracker::getSum(const ItemSelector& select) const {
+    std::vector<Money> parts(size());
+    forEachCategory([&](std::size_t i, const Category& c) {
+        for (const Item* item : select(c)) {
+            parts[i] += item->getAmount();
+        }
+    });
+    Money sum;
+    for (const Money& part : parts) {
+        sum += part;
+    }
+    return sum;
+}
+
+/**
+ * @brief Computes the sum of all expenses carrying a tag, across all categories.
+ *
+ * Each Category answers from its tag index, so only the matching items are visited.
+ *
+ * @param tag The tag.
+ * @return Money The total sum of the amounts of the expenses with the tag.
+ */
+Money ExpenseTracker::getSumForTag(const std::string& tag) const {
+    std::vector<Money> parts(size());
+    forEachCategory([&](std::size_t i, const Category& c) { parts[i] = c.getSumForTag(tag); });
+    Money sum;
+    for (const Money& part : parts) {
+        sum += part;
+    }
+    return sum;
+}
+
+/**
+ * @brief Computes the total sum of all expenses from scratch, visiting every item.
+ *
+ * Tests use this to check the running totals behind getSum().
+ *
+ * @return Money The total sum of all expense amounts.
+ */
+Money ExpenseTracker::recomputeSum() const {
+    std::vector<Money> parts(size());
+    forEachCategory([&](std::size_t i, const Category& c) { parts[i] = c.recomputeSum(); });
+    Money sum;
+    for (const Money& part : parts) {
+        sum += part;
+    }
+    return sum;
+}
+
+/**
+ * @brief Groups the chosen expenses of every category into a report.
+ *
+ * Each category is added to a report of its own, in parallel if more than one thread
+ * is set, and these are merged in category order. The selector may be called from
+ * several threads at once, for different categories.
+ *
+ * @param groupBy The dimensions to group by.
+ * @param tag If not empty, the only tag that items are grouped under when grouping by tag.
+ * @param select Chooses the items of each category to include, in date order.
+ * @return Report The grouped counts and sums.
+ */
+Report ExpenseTracker::report(const std::vector<Report::Dimension>& groupBy, const std::string& tag,
+                              const ItemSelector& select) const {
+    std::vector<Report> parts(size(), Report(groupBy, tag));
+    forEachCategory([&](std::size_t i, const Category& c) { parts[i].add(c, select(c)); });
+    Report result(groupBy, tag);
+    for (const Report& part : parts) {
+        result.merge(part);
+    }
+    return result;
+}
+
+/**
+ * @brief Finds the largest or most recent of the chosen expenses of every category.
+ *
+ * Each category keeps its own limit expenses, in parallel if more than one thread is
+ * set, and these are merged, so no more than limit expenses per category are ever
+ * ranked against each other. The selector may be called from several threads at once,
+ * for different categories, and must return items in date order.
+ *
+ * @param by Whether expenses rank by amount or by date.
+ * @param limit The number of expenses to find.
+ * @param select Chooses the items of each category to include, in date order.
+ * @return Top The expenses found.
+ */
+Top ExpenseTracker::top(Top::Order by, std::size_t limit, const ItemSelector& select) const {
+    std::vector<Top> parts(size(), Top(by, limit));
+    forEachCategory([&](std::size_t i, const Category& c) { parts[i].add(c, select(c)); });
+    Top result(by, limit);
+    for (const Top& part : parts) {
+        result.merge(part);
+    }
+    return result;
+}
+
+/**
+ * @brief Finds the chosen expenses of every category.
+ *
+ * The selector may be called from several threads at once, for different categories.
+ *
+ * @param select Chooses the items of each category to include.
+ * @return std::vector<std::pair<std::string, std::string>> The category and item
+ * identifier of each chosen expense, in category order.
+ */
+std::vector<std::pair<std::string, std::string>> ExpenseTracker::findItems(
+        const ItemSelector& select) const {
+    std::vector<std::vector<std::pair<std::string, std::string>>> parts(size());
+    forEachCategory([&](std::size_t i, const Category& c) {
+        for (const Item* item : select(c)) {
+            parts[i].push_back(std::make_pair(c.getIdent(), item->getIdent()));
+        }
+    });
+    std::vector<std::pair<std::string, std::string>> found;
+    for (const auto& part : parts) {
+        found.insert(found.end(), part.begin(), part.end());
+    }
+    return found;
+}
+
 /**
  * @brief Loads ExpenseTracker data from a JSON file.
  *
- * Opens the specified file, reads its contents, and populates the ExpenseTracker
- * container with Category and Item objects based on the JSON structure. The expected JSON format is:
+ * Maps the specified file into memory and parses it with a DatabaseLoader, which populates
+ * the ExpenseTracker container with Category and Item objects based on the JSON structure.
+ * Any changes recorded in the database's Journal are then replayed on top. Categories that were
+ * already loaded are merged into, and changes made before the call stay unsaved. The expected JSON format is:
  * {
  *   "Category1": {
  *      "ItemID1": { "amount": ..., "date": "...", "description": "...", "tags": [...] },
@@ -162,53 +650,263 @@ double ExpenseTracker::getSum() const {
  * }
  *
  * @param filename The path to the JSON file containing the database.
- * @throws std::runtime_error if the file cannot be opened.
+ * @throws std::runtime_error if the file cannot be opened, is not valid JSON, or an item
+ * has no amount, description or date.
  */
 void ExpenseTracker::load(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("File not found: " + filename);
+    // Map the whole file (or read it in one go where mmap is unavailable) and
+    // parse straight from the contiguous bytes, building the categories and
+    // items from the parser events rather than going through a JSON DOM. The
+    // categories are indexed first, so that a category that appears more than
+    // once is read from its last occurrence only, as open does.
+    MappedFile file(filename);
+    std::map<std::string, std::pair<std::size_t, std::size_t>> ranges;
+    DatabaseLoader::index(file.data(), file.size(), ranges);
+    const bool wasChanged = changed;
+    const auto dirty = dirtyCategories();
+    for (const auto& range : ranges) {
+        parseCategory(newCategory(range.first), file.data(), range.second);
     }
-    nlohmann::json j;
-    file >> j;
-    file.close();
-    // Process each category in the JSON
-    for (const auto& categoryJson : j.items()) {
-        // Create a temporary Category object to hold the items
-        Category tempCategory(categoryJson.key());
-        
-        // Add all items to the temporary category
-        for (const auto& itemJson : categoryJson.value().items()) {
-            Date d = Date(itemJson.value()["date"].get<std::string>());
-            Item i(itemJson.key(), 
-                   itemJson.value()["description"].get<std::string>(), 
-                   itemJson.value()["amount"].get<double>(), 
-                   d);
-            // Add tags to the item
-            for (const auto& tag : itemJson.value()["tags"]) {
-                i.addTag(tag);
-            }
-            tempCategory.addItem(i);
+    markLoaded(dirty, wasChanged);
+    Journal(filename).replay(*this);
+}
+
+/**
+ * @brief Opens a JSON database lazily, parsing each category only when it is first used.
+ *
+ * The file is mapped into memory and only the byte range of each top-level category is
+ * recorded. Functions that touch a single category (such as getCategory) parse just that
+ * category, while functions that need everything (such as getSum, str, or save) parse
+ * the rest. Any changes recorded in the database's Journal are replayed on top, and
+ * changes made before the call stay unsaved.
+ *
+ * @param filename The path to the JSON file containing the database.
+ * @throws std::runtime_error if the file cannot be opened or its top-level structure is invalid.
+ */
+void ExpenseTracker::open(const std::string& filename) {
+    auto file = std::make_shared<const MappedFile>(filename);
+    std::map<std::string, std::pair<std::size_t, std::size_t>> ranges;
+    DatabaseLoader::index(file->data(), file->size(), ranges);
+
+    materialiseAll();
+    const bool wasChanged = changed;
+    const auto dirty = dirtyCategories();
+    segments.clear();
+    source = file;
+    for (const auto& range : ranges) {
+        if (categories.count(range.first) == 0) {
+            unloaded.insert(range);
+        } else {
+            // Merge into the category that is already loaded, as load would.
+            DatabaseLoader loader(categories.find(range.first)->second);
+            nlohmann::json::sax_parse(file->data() + range.second.first,
+                                      file->data() + range.second.second, &loader);
         }
-        addCategory(tempCategory);
     }
+    markLoaded(dirty, wasChanged);
+    Journal(filename).replay(*this);
 }
 
 /**
  * @brief Saves the ExpenseTracker data to a JSON file.
  *
- * Serializes the ExpenseTracker object to a JSON-formatted string and writes it to the specified file.
+ * Serializes the ExpenseTracker object to JSON and streams it to the specified file through a
+ * FileWriter, so memory use does not grow with the size of the database. Each
+ * category is a segment of the file: categories of a lazily opened database that were never
+ * parsed, or were parsed but are still clean, are copied byte for byte from the opened file,
+ * and only dirty categories are serialized again. As the file now holds every change, any
+ * Journal kept for it is removed.
  *
  * @param filename The path of the file to which the data will be written.
  * @throws std::runtime_error if the file cannot be opened.
  */
 void ExpenseTracker::save(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("File not found: " + filename);
+    const std::string temp = filename + ".tmp";
+    FileWriter out(temp);
+    out.put('{');
+    auto c = categories.begin();
+    auto u = unloaded.begin();
+    size_t count = 0;
+    while (c != categories.end() || u != unloaded.end()) {
+        if (count > 0) {
+            out.put(',');
+        }
+        const std::pair<std::size_t, std::size_t>* range = nullptr;
+        const bool parsed = u == unloaded.end() || (c != categories.end() && c->first < u->first);
+        out.put('"');
+        out.write(parsed ? c->first : u->first);
+        out.write("\":", 2);
+        if (parsed) {
+            auto segment = segments.find(c->first);
+            if (segment != segments.end() && !c->second.isDirty()) {
+                range = &segment->second;
+            } else {
+                c->second.write(out);
+            }
+            ++c;
+        } else {
+            range = &u->second;
+            ++u;
+        }
+        if (range != nullptr) {
+            out.write(source->data() + range->first, range->second - range->first);
+        }
+        count++;
     }
-    file << str();
+    out.put('}');
+    out.close();
+    replaceFile(temp, filename);
+    Journal(filename).discard();
+}
+
+/**
+ * @brief Loads ExpenseTracker data from a binary snapshot written by saveBinary.
+ *
+ * The snapshot layout (all integers little-endian, strings prefixed with a
+ * 32-bit length) is:
+ *   magic "371E", version,
+ *   tag count, tag strings,
+ *   category count, one 64-bit file offset per category,
+ *   per category: identifier, item count, and per item: identifier,
+ *   description, amount, date, tag count, tag ids.
+ * Amounts are 64-bit counts of hundredths and dates are serial days (see
+ * Date::getSerial). Only snapshots of the current version can be loaded.
+ * As with load, changes recorded in the database's Journal are replayed on top, and
+ * changes made before the call stay unsaved.
+ *
+ * @param filename The path to the binary snapshot.
+ * @throws std::runtime_error if the file cannot be opened, is not a valid snapshot or
+ * is of another version.
+ */
+void ExpenseTracker::loadBinary(const std::string& filename) {
+    MappedFile file(filename);
+    BinaryReader in(file.data(), file.size());
+    if (in.readU32() != BINARY_MAGIC) {
+        throw std::runtime_error("Invalid binary database: " + filename);
+    }
+    if (in.readU32() != BINARY_VERSION) {
+        throw std::runtime_error("Unsupported binary database version: " + filename);
+    }
+
+    const bool wasChanged = changed;
+    const auto dirty = dirtyCategories();
+    std::vector<TagId> tags(in.readU32());
+    for (auto& tag : tags) {
+        tag = TagDictionary::intern(in.readString());
+    }
+
+    std::vector<std::uint64_t> offsets(in.readU32());
+    for (auto& offset : offsets) {
+        offset = in.readU64();
+    }
+
+    for (const auto offset : offsets) {
+        in.seek(offset);
+        Category& category = newCategory(in.readString());
+        std::uint32_t numItems = in.readU32();
+        for (std::uint32_t i = 0; i < numItems; i++) {
+            std::string id = in.readString();
+            std::string desc = in.readString();
+            Money amount = Money::fromUnits(static_cast<std::int64_t>(in.readU64()));
+            Date date = Date::fromSerial(in.readU32());
+            Item& item = category.newItem(id, desc, amount, date);
+            std::uint32_t numTags = in.readU32();
+            for (std::uint32_t t = 0; t < numTags; t++) {
+                std::uint32_t tagId = in.readU32();
+                if (tagId >= tags.size()) {
+                    throw std::runtime_error("Invalid binary database: unknown tag id");
+                }
+                item.addTagId(tags[tagId]);
+            }
+        }
+    }
+    markLoaded(dirty, wasChanged);
+    Journal(filename).replay(*this);
+}
+
+/**
+ * @brief Saves the ExpenseTracker data as a binary snapshot.
+ *
+ * Tags are written once to a table and referenced by id from each item, and the
+ * start of every category is recorded in an offset table. See loadBinary for the layout.
+ * Any Journal kept for the file is removed.
+ *
+ * @param filename The path of the file to which the snapshot will be written.
+ * @throws std::runtime_error if the file cannot be opened.
+ */
+void ExpenseTracker::saveBinary(const std::string& filename) const {
+    materialiseAll();
+    // The file numbers its tags from 0 in the order they are first written, as
+    // TagDictionary ids are only meaningful within this process.
+    std::unordered_map<TagId, std::uint32_t> tagIds;
+    std::vector<TagId> tags;
+    for (const auto& cpair : categories) {
+        for (const auto& ipair : cpair.second.getItems()) {
+            for (const TagId tag : ipair.second.getTagIds()) {
+                if (tagIds.insert(std::make_pair(tag, static_cast<std::uint32_t>(tags.size()))).second) {
+                    tags.push_back(tag);
+                }
+            }
+        }
+    }
+
+    BinaryWriter out;
+    out.writeU32(BINARY_MAGIC);
+    out.writeU32(BINARY_VERSION);
+    out.writeU32(static_cast<std::uint32_t>(tags.size()));
+    for (const TagId tag : tags) {
+        out.writeString(TagDictionary::name(tag));
+    }
+
+    out.writeU32(static_cast<std::uint32_t>(categories.size()));
+    const std::size_t offsetTable = out.size();
+    for (std::size_t i = 0; i < categories.size(); i++) {
+        out.writeU64(0);
+    }
+
+    std::size_t index = 0;
+    for (const auto& cpair : categories) {
+        out.patchU64(offsetTable + 8 * index++, out.size());
+        out.writeString(cpair.first);
+        out.writeU32(cpair.second.size());
+        for (const auto& ipair : cpair.second.getItems()) {
+            const Item& item = ipair.second;
+            out.writeString(ipair.first);
+            out.writeString(item.getDescription());
+            out.writeU64(static_cast<std::uint64_t>(item.getAmount().getUnits()));
+            out.writeU32(item.getDate().getSerial());
+            out.writeU32(item.numTags());
+            for (const TagId tag : item.getTagIds()) {
+                out.writeU32(tagIds.find(tag)->second);
+            }
+        }
+    }
+
+    const std::string temp = filename + ".tmp";
+    FileWriter file(temp);
+    file.write(out.data());
     file.close();
+    replaceFile(temp, filename);
+    Journal(filename).discard();
+}
+
+/**
+ * @brief Checks whether a file holds a binary snapshot rather than JSON.
+ *
+ * Only the leading magic bytes are inspected.
+ *
+ * @param filename The path of the file to check.
+ * @return true if the file starts with the binary snapshot magic; false otherwise,
+ *         including when the file cannot be opened.
+ */
+bool ExpenseTracker::isBinary(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[4];
+    if (!file.read(magic, sizeof(magic))) {
+        return false;
+    }
+    BinaryReader in(magic, sizeof(magic));
+    return in.readU32() == BINARY_MAGIC;
 }
 
 /**
@@ -220,28 +918,83 @@ void ExpenseTracker::save(const std::string& filename) const {
  * @return true if both ExpenseTracker objects are equal; false otherwise.
  */
 bool ExpenseTracker::operator==(const ExpenseTracker& other) const {
+    materialiseAll();
+    other.materialiseAll();
     return categories == other.categories;
 }
 
 /**
  * @brief Returns the JSON representation of the ExpenseTracker data.
  *
- * Constructs a JSON-formatted string representing all categories and their contained items.
- *
  * @return std::string The JSON string representation of the ExpenseTracker.
  */
 std::string ExpenseTracker::str() const {
-    std::ostringstream os;
-    os << "{";
+    StringWriter out;
+    write(out);
+    return out.str();
+}
+
+/**
+ * @brief Writes the JSON representation of the ExpenseTracker data.
+ *
+ * Writes a JSON object representing all categories and their contained items.
+ *
+ * @param out The Writer to write to.
+ */
+void ExpenseTracker::write(Writer& out) const {
+    materialiseAll();
+    out.put('{');
+    size_t count = 0;
+    for (const auto& pair : categories) {
+        if (count > 0) {
+            out.put(',');
+        }
+        out.put('"');
+        out.write(pair.first);
+        out.write("\":", 2);
+        pair.second.write(out);
+        count++;
+    }
+    out.put('}');
+}
+
+/**
+ * @brief Writes the JSON representation of the expenses dated between two dates.
+ *
+ * @param out The Writer to write to.
+ * @param from The first date included.
+ * @param to The last date included.
+ */
+void ExpenseTracker::write(Writer& out, const Date& from, const Date& to) const {
+    write(out, [&from, &to](const Category& c) { return c.getItems(from, to); });
+}
+
+/**
+ * @brief Writes the JSON representation of the chosen expenses.
+ *
+ * Writes the same JSON object as write(Writer&), but with only the chosen items.
+ * Categories without any chosen items are left out.
+ *
+ * @param out The Writer to write to.
+ * @param select Chooses the items of each category to include.
+ */
+void ExpenseTracker::write(Writer& out, const ItemSelector& select) const {
+    materialiseAll();
+    out.put('{');
     size_t count = 0;
     for (const auto& pair : categories) {
+        const std::vector<const Item*> selection = select(pair.second);
+        if (selection.empty()) {
+            continue;
+        }
         if (count > 0) {
-            os << ",";
+            out.put(',');
         }
-        os << "\"" << pair.first << "\":";
-        os << pair.second.str();
+        out.put('"');
+        out.write(pair.first);
+        out.write("\":", 2);
+        pair.second.write(out, selection);
         count++;
     }
-    os << "}";
-    return os.str();
+    out.put('}');
 }
@@ -15,29 +15,82 @@
 #define EXPENSETRACKER_H
 
 #include "category.h"
+#include "report.h"
+#include "top.h"
+#include <cstddef>
+#include <functional>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <stdexcept>
 #include <iostream>
 #include <fstream>
 
+class MappedFile;
+class ThreadPool;
 
 class ExpenseTracker {
+public:
+    // Chooses which items of a category to include in a query.
+    typedef std::function<std::vector<const Item*>(const Category&)> ItemSelector;
+
 private:
-    std::map<std::string, Category> categories;
+    // Categories are parsed on first use when the database was opened lazily,
+    // which may happen from const member functions. Until then, and for as long
+    // as a parsed category stays clean, its JSON is the byte range in source.
+    mutable IdentMap<Category> categories;
+    mutable std::map<std::string, std::pair<std::size_t, std::size_t>, std::less<>> unloaded;
+    mutable std::map<std::string, std::pair<std::size_t, std::size_t>, std::less<>> segments;
+    mutable std::shared_ptr<const MappedFile> source;
+    // Whether categories were added or deleted since the last load.
+    bool changed;
+    // The threads that work on categories in parallel, or null to work serially.
+    std::shared_ptr<ThreadPool> pool;
+
+    void materialise(std::string_view id) const;
+    void materialiseAll() const;
+    void forEachCategory(const std::function<void(std::size_t, const Category&)>& task) const;
+    std::set<std::string, std::less<>> dirtyCategories() const;
+    void markLoaded(const std::set<std::string, std::less<>>& dirty, bool wasChanged);
 
 public:
     ExpenseTracker();
+    void setThreads(unsigned int threads);
+    unsigned int getThreads() const;
     unsigned int size() const;
     Category& newCategory(const std::string& id);
     bool addCategory(const Category& category);
-    const Category& getCategory(const std::string& id) const;
-    Category& getCategory(const std::string& id);
-    bool deleteCategory(const std::string& id);
-    double getSum() const;
+    bool addCategory(Category&& category);
+    const Category& getCategory(std::string_view id) const;
+    Category& getCategory(std::string_view id);
+    bool deleteCategory(std::string_view id);
+    bool isDirty() const;
+    Money getSum() const;
+    Money getSum(const Date& from, const Date& to) const;
+    Money getSum(const Date& from, const Date& to, const std::string& tag) const;
+    Money getSum(const ItemSelector& select) const;
+    Money getSumForTag(const std::string& tag) const;
+    Aggregate getStats(const Date& from, const Date& to) const;
+    Aggregate getStats(const Date& from, const Date& to, const std::string& tag) const;
+    Money recomputeSum() const;
+    Report report(const std::vector<Report::Dimension>& groupBy, const std::string& tag,
+                  const ItemSelector& select) const;
+    Top top(Top::Order by, std::size_t limit, const ItemSelector& select) const;
+    std::vector<std::pair<std::string, std::string>> findItems(const ItemSelector& select) const;
     void load(const std::string& filename);
+    void open(const std::string& filename);
     void save(const std::string& filename) const;
+    void loadBinary(const std::string& filename);
+    void saveBinary(const std::string& filename) const;
+    static bool isBinary(const std::string& filename);
     std::string str() const;
+    void write(Writer& out) const;
+    void write(Writer& out, const Date& from, const Date& to) const;
+    void write(Writer& out, const ItemSelector& select) const;
 
     bool operator==(const ExpenseTracker& other) const;
 };
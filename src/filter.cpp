@@ -0,0 +1,429 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "filter.h"
+#include "text.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * @brief Checks whether a string contains a lowercase needle, ignoring case.
+ *
+ * @param text The string to search.
+ * @param needle The lowercase string to find.
+ * @return true if the needle occurs in the text.
+ */
+static bool containsIgnoringCase(std::string_view text, const std::string& needle) {
+    return std::search(text.begin(), text.end(), needle.begin(), needle.end(),
+                       [](char a, char b) { return lower(a) == b; }) != text.end();
+}
+
+/**
+ * @brief Checks whether a string equals a lowercase string, ignoring case.
+ *
+ * @param text The string to compare.
+ * @param other The lowercase string to compare against.
+ * @return true if they are equal ignoring case.
+ */
+static bool equalsIgnoringCase(std::string_view text, const std::string& other) {
+    return text.size() == other.size() &&
+           std::equal(text.begin(), text.end(), other.begin(),
+                      [](char a, char b) { return lower(a) == b; });
+}
+
+/**
+ * @brief Parses a filter expression.
+ *
+ * Conditions are "amount OP number", "date OP YYYY-MM-DD", "tag:name", and
+ * "desc OP text" (or "description"), where OP is one of ==, !=, <, <=, > and >=, or
+ * ~ for descriptions containing the text. Descriptions only support ~, == and !=,
+ * all ignoring case. Conditions combine with &&, || and !, and group with brackets;
+ * && binds tighter than ||. Tags and text may be double quoted, and must be if they
+ * contain spaces or operator characters. An empty expression matches every item.
+ *
+ * @param expression The expression.
+ * @throws std::invalid_argument if the expression is not valid.
+ */
+Filter::Filter(const std::string& expression)
+    : root(0), from(Date::earliest()), to(Date::latest()) {
+    const std::vector<Token> tokens = tokenize(expression);
+    if (tokens.empty()) {
+        return;
+    }
+    std::size_t pos = 0;
+    root = parseOr(tokens, pos);
+    if (pos != tokens.size()) {
+        throw std::invalid_argument("where");
+    }
+    findRequired(root);
+}
+
+/**
+ * @brief Splits an expression into operators, words and quoted strings.
+ *
+ * @param expression The expression.
+ * @return std::vector<Filter::Token> The tokens.
+ * @throws std::invalid_argument if a quoted string is not terminated.
+ */
+std::vector<Filter::Token> Filter::tokenize(const std::string& expression) {
+    static const char* operators[] = {"&&", "||", "==", "!=", "<=", ">=",
+                                      "<", ">", "!", "~", "(", ")", ":"};
+    static const char* special = "\"&|=!<>~():";
+    std::vector<Token> tokens;
+    std::size_t i = 0;
+    while (i < expression.size()) {
+        const char c = expression[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            i++;
+            continue;
+        }
+        if (c == '"') {
+            std::string text;
+            for (i++; i < expression.size() && expression[i] != '"'; i++) {
+                if (expression[i] == '\\' && i + 1 < expression.size()) {
+                    i++;
+                }
+                text += expression[i];
+            }
+            if (i == expression.size()) {
+                throw std::invalid_argument("where");
+            }
+            i++;
+            tokens.push_back(Token{text, true});
+            continue;
+        }
+        bool found = false;
+        for (const char* op : operators) {
+            const std::size_t n = std::strlen(op);
+            if (expression.compare(i, n, op) == 0) {
+                tokens.push_back(Token{op, false});
+                i += n;
+                found = true;
+                break;
+            }
+        }
+        if (found) {
+            continue;
+        }
+        const std::size_t begin = i;
+        while (i < expression.size() && !std::isspace(static_cast<unsigned char>(expression[i])) &&
+               std::strchr(special, expression[i]) == nullptr) {
+            i++;
+        }
+        tokens.push_back(Token{expression.substr(begin, i - begin), false});
+    }
+    return tokens;
+}
+
+/**
+ * @brief Checks whether the token at a position is an operator.
+ *
+ * @param tokens The tokens.
+ * @param pos The position.
+ * @param op The operator.
+ * @return true if the token at pos is op, and not a quoted string.
+ */
+bool Filter::isOperator(const std::vector<Token>& tokens, std::size_t pos, const char* op) {
+    return pos < tokens.size() && !tokens[pos].quoted && tokens[pos].text == op;
+}
+
+/**
+ * @brief Parses conditions joined by ||.
+ *
+ * @param tokens The tokens.
+ * @param pos The position of the first token, moved past the last one parsed.
+ * @return std::size_t The node parsed.
+ * @throws std::invalid_argument if the tokens are not valid.
+ */
+std::size_t Filter::parseOr(const std::vector<Token>& tokens, std::size_t& pos) {
+    std::size_t left = parseAnd(tokens, pos);
+    while (isOperator(tokens, pos, "||")) {
+        pos++;
+        const std::size_t right = parseAnd(tokens, pos);
+        left = addNode(Node{OR, EQ, Money(), Date(), "", left, right});
+    }
+    return left;
+}
+
+/**
+ * @brief Parses conditions joined by &&.
+ *
+ * @param tokens The tokens.
+ * @param pos The position of the first token, moved past the last one parsed.
+ * @return std::size_t The node parsed.
+ * @throws std::invalid_argument if the tokens are not valid.
+ */
+std::size_t Filter::parseAnd(const std::vector<Token>& tokens, std::size_t& pos) {
+    std::size_t left = parseUnary(tokens, pos);
+    while (isOperator(tokens, pos, "&&")) {
+        pos++;
+        const std::size_t right = parseUnary(tokens, pos);
+        left = addNode(Node{AND, EQ, Money(), Date(), "", left, right});
+    }
+    return left;
+}
+
+/**
+ * @brief Parses a negated or bracketed condition, or a single condition.
+ *
+ * @param tokens The tokens.
+ * @param pos The position of the first token, moved past the last one parsed.
+ * @return std::size_t The node parsed.
+ * @throws std::invalid_argument if the tokens are not valid.
+ */
+std::size_t Filter::parseUnary(const std::vector<Token>& tokens, std::size_t& pos) {
+    if (isOperator(tokens, pos, "!")) {
+        pos++;
+        const std::size_t child = parseUnary(tokens, pos);
+        return addNode(Node{NOT, EQ, Money(), Date(), "", child, child});
+    }
+    if (isOperator(tokens, pos, "(")) {
+        pos++;
+        const std::size_t node = parseOr(tokens, pos);
+        if (!isOperator(tokens, pos, ")")) {
+            throw std::invalid_argument("where");
+        }
+        pos++;
+        return node;
+    }
+    return parseComparison(tokens, pos);
+}
+
+/**
+ * @brief Parses a single condition on the amount, date, tags or description.
+ *
+ * @param tokens The tokens.
+ * @param pos The position of the first token, moved past the last one parsed.
+ * @return std::size_t The node parsed.
+ * @throws std::invalid_argument if the tokens are not a valid condition.
+ */
+std::size_t Filter::parseComparison(const std::vector<Token>& tokens, std::size_t& pos) {
+    if (pos + 2 >= tokens.size() || tokens[pos].quoted || tokens[pos + 1].quoted) {
+        throw std::invalid_argument("where");
+    }
+    std::string field = tokens[pos].text;
+    std::transform(field.begin(), field.end(), field.begin(), lower);
+    const std::string& op = tokens[pos + 1].text;
+    const Token& operand = tokens[pos + 2];
+    if (!operand.quoted && std::strchr("&|=!<>~():", operand.text[0]) != nullptr) {
+        throw std::invalid_argument("where");
+    }
+    pos += 3;
+
+    Node node{TAG, EQ, Money(), Date(), operand.text, 0, 0};
+    if (field == "tag") {
+        if (op != ":") {
+            throw std::invalid_argument("where");
+        }
+        return addNode(node);
+    }
+
+    if (op == "==") node.op = EQ;
+    else if (op == "!=") node.op = NE;
+    else if (op == "<") node.op = LT;
+    else if (op == "<=") node.op = LE;
+    else if (op == ">") node.op = GT;
+    else if (op == ">=") node.op = GE;
+    else if (op == "~") node.op = CONTAINS;
+    else throw std::invalid_argument("where");
+
+    if (field == "amount" && node.op != CONTAINS) {
+        node.kind = AMOUNT;
+        node.amount = Money::parse(operand.text);
+    } else if (field == "date" && node.op != CONTAINS) {
+        node.kind = DATE;
+        node.date = Date(operand.text);
+    } else if ((field == "desc" || field == "description") &&
+               (node.op == EQ || node.op == NE || node.op == CONTAINS)) {
+        node.kind = DESCRIPTION;
+        std::transform(node.text.begin(), node.text.end(), node.text.begin(), lower);
+    } else {
+        throw std::invalid_argument("where");
+    }
+    return addNode(node);
+}
+
+/**
+ * @brief Adds a node to the tree.
+ *
+ * @param node The node.
+ * @return std::size_t The position of the node.
+ */
+std::size_t Filter::addNode(const Node& node) {
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+/**
+ * @brief Narrows the date range, tag and description text that every match must
+ * meet, from the conditions reached from a node through ANDs only.
+ *
+ * @param node The node.
+ */
+void Filter::findRequired(std::size_t node) {
+    const Node& n = nodes[node];
+    switch (n.kind) {
+        case AND:
+            findRequired(n.left);
+            findRequired(n.right);
+            break;
+        case DATE:
+            // Strict bounds keep the date itself; evaluating the node drops it.
+            if ((n.op == EQ || n.op == GE || n.op == GT) && from < n.date) {
+                from = n.date;
+            }
+            if ((n.op == EQ || n.op == LE || n.op == LT) && n.date < to) {
+                to = n.date;
+            }
+            break;
+        case TAG:
+            if (requiredTag.empty()) {
+                requiredTag = n.text;
+            }
+            break;
+        case DESCRIPTION:
+            if ((n.op == EQ || n.op == CONTAINS) && n.text.size() > requiredText.size()) {
+                requiredText = n.text;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Compares two values with an operator.
+ *
+ * @param a The left value.
+ * @param op The operator, other than CONTAINS.
+ * @param b The right value.
+ * @return true if "a op b" holds.
+ */
+template <typename T>
+bool Filter::compare(const T& a, Op op, const T& b) {
+    switch (op) {
+        case EQ: return a == b;
+        case NE: return !(a == b);
+        case LT: return a < b;
+        case LE: return !(b < a);
+        case GT: return b < a;
+        case GE: return !(a < b);
+        default: return false;
+    }
+}
+
+/**
+ * @brief Looks up the ids of the tags that TAG nodes compare against.
+ *
+ * Tags are looked up when items are checked rather than when the filter is parsed,
+ * as the tags of a lazily opened database only have ids once their category is parsed.
+ * Look them up once for all the items checked together, as select does.
+ *
+ * @return std::vector<TagId> The id of the tag of each TAG node, by node, or
+ * TagDictionary::NONE if no item carries it.
+ */
+std::vector<TagId> Filter::findTags() const {
+    std::vector<TagId> tags(nodes.size(), TagDictionary::NONE);
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i].kind == TAG) {
+            TagDictionary::find(nodes[i].text, tags[i]);
+        }
+    }
+    return tags;
+}
+
+/**
+ * @brief Evaluates a node of the tree for an item.
+ *
+ * @param node The node.
+ * @param item The item.
+ * @param tags The ids of the tags of the TAG nodes, as returned by findTags.
+ * @return true if the item meets the condition of the node.
+ */
+bool Filter::evaluate(std::size_t node, const Item& item, const std::vector<TagId>& tags) const {
+    const Node& n = nodes[node];
+    switch (n.kind) {
+        case AND:
+            return evaluate(n.left, item, tags) && evaluate(n.right, item, tags);
+        case OR:
+            return evaluate(n.left, item, tags) || evaluate(n.right, item, tags);
+        case NOT:
+            return !evaluate(n.left, item, tags);
+        case AMOUNT:
+            return compare(item.getAmount(), n.op, n.amount);
+        case DATE:
+            return compare(item.getDate(), n.op, n.date);
+        case TAG:
+            return item.containsTagId(tags[node]);
+        case DESCRIPTION:
+            if (n.op == CONTAINS) {
+                return containsIgnoringCase(item.getDescription(), n.text);
+            }
+            return equalsIgnoringCase(item.getDescription(), n.text) == (n.op == EQ);
+    }
+    return false;
+}
+
+/**
+ * @brief Checks whether an item meets the filter.
+ *
+ * @param item The item.
+ * @param tags The ids of the tags of the filter, as returned by findTags.
+ * @return true if the item matches.
+ */
+bool Filter::matches(const Item& item, const std::vector<TagId>& tags) const {
+    return nodes.empty() || evaluate(root, item, tags);
+}
+
+/**
+ * @brief Retrieves the items of a category that meet the filter, and are dated
+ * between two dates and carry a tag.
+ *
+ * Candidates come from the trigram index if it is built and every match must contain a
+ * description of three or more characters, and otherwise from the date-ordered columns,
+ * limited to the narrowest date range and a tag every match must carry. Only candidates
+ * are evaluated. The index is not built here, as building it costs more than checking
+ * the descriptions of the candidates.
+ *
+ * @param c The Category.
+ * @param from The first date included.
+ * @param to The last date included.
+ * @param tag If not empty, a tag every item must carry.
+ * @return std::vector<const Item*> The matching items, ordered by date.
+ */
+std::vector<const Item*> Filter::select(const Category& c, const Date& from, const Date& to,
+                                        const std::string& tag) const {
+    const Date first = from < this->from ? this->from : from;
+    const Date last = this->to < to ? this->to : to;
+    std::vector<const Item*> candidates;
+    if (requiredText.size() >= 3 && c.hasSearchIndex()) {
+        candidates = c.search(requiredText);
+    } else if (!tag.empty()) {
+        candidates = c.getItems(first, last, tag);
+    } else if (!requiredTag.empty()) {
+        candidates = c.getItems(first, last, requiredTag);
+    } else {
+        candidates = c.getItems(first, last);
+    }
+    TagId tagId = TagDictionary::NONE;
+    TagDictionary::find(tag, tagId);
+    const std::vector<TagId> tags = findTags();
+    std::vector<const Item*> selection;
+    for (const Item* item : candidates) {
+        const Date date = item->getDate();
+        if (!(date < first) && !(last < date) && (tag.empty() || item->containsTagId(tagId)) &&
+            matches(*item, tags)) {
+            selection.push_back(item);
+        }
+    }
+    return selection;
+}
@@ -0,0 +1,81 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// A Filter is a condition on expense items, such as
+//   amount > 20 && tag:uni && date >= 2024-01-01 && desc ~ "coffee"
+// parsed once into a tree of nodes held in a vector. The
+// conditions that every match must meet narrow the date
+// range, tag or description searched for, so selecting
+// the matches of a Category starts from its date, tag or
+// trigram index rather than from all of its items.
+// -----------------------------------------------------
+
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "category.h"
+
+class Filter
+{
+private:
+    enum Kind { AND, OR, NOT, AMOUNT, DATE, TAG, DESCRIPTION };
+    enum Op { EQ, NE, LT, LE, GT, GE, CONTAINS };
+
+    // A node of the tree. AND and OR have two children, NOT has one (left). The
+    // other kinds compare an item's field to amount, date or text (a tag, or a
+    // lowercased description).
+    struct Node
+    {
+        Kind kind;
+        Op op;
+        Money amount;
+        Date date;
+        std::string text;
+        std::size_t left;
+        std::size_t right;
+    };
+
+    struct Token
+    {
+        std::string text;
+        bool quoted;
+    };
+
+    std::vector<Node> nodes;
+    // The root node, or nodes.size() if the filter is empty and matches everything.
+    std::size_t root;
+    // What every match must meet, found by following the ANDs from the root.
+    Date from;
+    Date to;
+    std::string requiredTag;
+    std::string requiredText;
+
+    static std::vector<Token> tokenize(const std::string& expression);
+    static bool isOperator(const std::vector<Token>& tokens, std::size_t pos, const char* op);
+    std::size_t parseOr(const std::vector<Token>& tokens, std::size_t& pos);
+    std::size_t parseAnd(const std::vector<Token>& tokens, std::size_t& pos);
+    std::size_t parseUnary(const std::vector<Token>& tokens, std::size_t& pos);
+    std::size_t parseComparison(const std::vector<Token>& tokens, std::size_t& pos);
+    std::size_t addNode(const Node& node);
+    void findRequired(std::size_t node);
+    bool evaluate(std::size_t node, const Item& item, const std::vector<TagId>& tags) const;
+    template <typename T> static bool compare(const T& a, Op op, const T& b);
+
+public:
+    Filter(const std::string& expression);
+
+    std::vector<TagId> findTags() const;
+    bool matches(const Item& item, const std::vector<TagId>& tags) const;
+    std::vector<const Item*> select(const Category& c, const Date& from, const Date& to,
+                                    const std::string& tag = "") const;
+};
+
+#endif // FILTER_H
@@ -8,12 +8,10 @@
 // -----------------------------------------------------
 
 #include "item.h"
+#include "category.h"
+#include "writer.h"
 #include "lib_json.hpp"
-#include <sstream>
-#include <ostream>
-#include <iomanip>
 #include <algorithm>
-#include <cmath>
 
 /**
  * @brief Constructs an Item object with the given identifier, description, amount, and date.
@@ -25,46 +23,225 @@
  * @param amt The monetary amount associated with the item.
  * @param d The date associated with the item.
  */
-Item::Item(const std::string& id, const std::string& desc, double amt, const Date& d) 
-    : identifier(id), description(desc), amount(amt), date(d) {}
+Item::Item(const std::string& id, const std::string& desc, const Money& amt, const Date& d) 
+    : owner(nullptr), identifier(id), description(desc.data(), desc.size()), amount(amt), date(d) {}
+
+/**
+ * @brief Constructs an Item object from a floating-point amount, rounded to the nearest hundredth.
+ *
+ * @param id The unique identifier for the item.
+ * @param desc A description of the item.
+ * @param amt The amount, e.g. 2.55.
+ * @param d The date associated with the item.
+ * @throws std::out_of_range if the amount is not finite or too large to hold.
+ */
+Item::Item(const std::string& id, const std::string& desc, double amt, const Date& d)
+    : Item(id, desc, Money(amt), d) {}
+
+/**
+ * @brief Constructs an Item object whose description is allocated from an Arena.
+ *
+ * Used by Category for the items it creates, which live no longer than its Arena.
+ *
+ * @param id A unique identifier for the item.
+ * @param desc A description of the item.
+ * @param amt The monetary amount associated with the item.
+ * @param d The date associated with the item.
+ * @param arena The Arena, or null to allocate from the heap.
+ */
+Item::Item(const std::string& id, const std::string& desc, const Money& amt, const Date& d,
+           Arena* arena)
+    : owner(nullptr), identifier(id),
+      description(desc.data(), desc.size(), ArenaAllocator<char>(arena)), amount(amt), date(d) {}
+
+/**
+ * @brief Copy constructor for the Item class.
+ *
+ * The copy does not belong to any Category until it is added to one.
+ *
+ * @param other The Item to copy.
+ */
+Item::Item(const Item& other)
+    : owner(nullptr), identifier(other.identifier), description(other.description),
+      amount(other.amount), date(other.date), tags(other.tags) {}
+
+/**
+ * @brief Copies an Item, allocating the description of the copy from an Arena.
+ *
+ * @param other The Item to copy.
+ * @param arena The Arena, or null to allocate from the heap.
+ */
+Item::Item(const Item& other, Arena* arena)
+    : owner(nullptr), identifier(other.identifier),
+      description(other.description.data(), other.description.size(), ArenaAllocator<char>(arena)),
+      amount(other.amount), date(other.date), tags(other.tags) {}
+
+/**
+ * @brief Move constructor for the Item class.
+ *
+ * The description keeps its memory, and so stays in the Arena it was allocated from,
+ * if any. Like a copy, the new item does not belong to any Category until it is added to one.
+ *
+ * @param other The Item to move from.
+ */
+Item::Item(Item&& other) noexcept
+    : owner(nullptr), identifier(std::move(other.identifier)),
+      description(std::move(other.description)), amount(other.amount), date(other.date),
+      tags(std::move(other.tags)) {}
+
+/**
+ * @brief Copy assignment operator for the Item class.
+ *
+ * Copies the data of another item but stays in its own Category, which is told about the change.
+ *
+ * @param other The Item to copy.
+ * @return Item& Reference to this item.
+ */
+Item& Item::operator=(const Item& other) {
+    if (this != &other) {
+        const Money old = amount;
+        if (owner != nullptr) {
+            owner->unindexTags(*this);
+            owner->unindexDescription(*this);
+        }
+        identifier = other.identifier;
+        description = other.description;
+        amount = other.amount;
+        date = other.date;
+        tags = other.tags;
+        if (owner != nullptr) {
+            owner->indexTags(*this);
+            owner->indexDescription(*this);
+        }
+        amountModified(old);
+        modified();
+    }
+    return *this;
+}
+
+/**
+ * @brief Move assignment operator for the Item class.
+ *
+ * As copy assignment, but the identifier and description are moved when the
+ * description can stay where it is (see canMoveInto).
+ *
+ * @param other The Item to move from.
+ * @return Item& Reference to this item.
+ */
+Item& Item::operator=(Item&& other) {
+    if (this != &other) {
+        const Money old = amount;
+        if (owner != nullptr) {
+            owner->unindexTags(*this);
+            owner->unindexDescription(*this);
+        }
+        identifier = std::move(other.identifier);
+        if (other.canMoveInto(description.get_allocator().getArena())) {
+            description = std::move(other.description);
+        } else {
+            description.assign(other.description.data(), other.description.size());
+        }
+        amount = other.amount;
+        date = other.date;
+        tags = std::move(other.tags);
+        if (owner != nullptr) {
+            owner->indexTags(*this);
+            owner->indexDescription(*this);
+        }
+        amountModified(old);
+        modified();
+    }
+    return *this;
+}
+
+/**
+ * @brief Checks whether the description can be moved into storage that lives as long as an Arena.
+ *
+ * It can if it is on the heap, or already in that Arena; a description in another
+ * Arena would be freed with it.
+ *
+ * @param arena The Arena, or null for the heap.
+ * @return true if the description can be moved.
+ */
+bool Item::canMoveInto(const Arena* arena) const {
+    const Arena* from = description.get_allocator().getArena();
+    return from == nullptr || from == arena;
+}
+
+/**
+ * @brief Tells the owning Category, if any, that this item has changed.
+ */
+void Item::modified() {
+    if (owner != nullptr) {
+        owner->itemModified();
+    }
+}
+
+/**
+ * @brief Tells the owning Category, if any, that this item's amount has changed.
+ *
+ * @param old The amount before the change.
+ */
+void Item::amountModified(const Money& old) {
+    if (owner != nullptr) {
+        owner->itemAmountModified(old, amount);
+    }
+}
 
 /**
  * @brief Retrieves the identifier of the item.
  *
- * @return std::string The unique identifier of the item.
+ * @return const std::string& The unique identifier of the item.
  */
-std::string Item::getIdent() const {
+const std::string& Item::getIdent() const {
     return identifier;
 }
 
 /**
  * @brief Retrieves the description of the item.
  *
- * @return std::string The description text of the item.
+ * @return std::string_view The description text of the item, valid until it changes.
  */
-std::string Item::getDescription() const {
-    return description;
+std::string_view Item::getDescription() const {
+    return std::string_view(description.data(), description.size());
 }
 
 /**
  * @brief Updates the description of the item.
  *
- * Sets a new description for the item.
+ * Sets a new description for the item, and tells the owning Category so that it can
+ * keep its trigram index up to date.
  *
  * @param desc The new description to be assigned to the item.
  */
-void Item::setDescription(const std::string& desc) {
-    description = desc;
+void Item::setDescription(std::string_view desc) {
+    if (owner != nullptr) {
+        owner->unindexDescription(*this);
+    }
+    description.assign(desc.data(), desc.size());
+    if (owner != nullptr) {
+        owner->indexDescription(*this);
+    }
+    modified();
 }
 
 /**
  * @brief Retrieves the tags associated with the item.
  *
- * Provides a constant reference to the vector containing all tags.
+ * Provides a view of the item's tag ids as the tag strings.
+ *
+ * @return TagNames The tags, valid until the item's tags change.
+ */
+TagNames Item::getTags() const {
+    return TagNames(tags);
+}
+
+/**
+ * @brief Retrieves the ids of the tags associated with the item.
  *
- * @return const std::vector<std::string>& The container of tags.
+ * @return const TagList& The ids of the tags, in the order they were added.
  */
-const std::vector<std::string>& Item::getTags() const {
+const TagList& Item::getTagIds() const {
     return tags;
 }
 
@@ -76,12 +253,24 @@ const std::vector<std::string>& Item::getTags() const {
  * @param tag The tag string to add.
  * @return true if the tag was inserted; false if the tag already existed.
  */
-bool Item::addTag(const std::string& tag) {
-    auto it = std::find(tags.begin(), tags.end(), tag);
-    if (it != tags.end()) {
+bool Item::addTag(std::string_view tag) {
+    return addTagId(TagDictionary::intern(tag));
+}
+
+/**
+ * @brief Adds a new tag to the item by its id.
+ *
+ * @param tag The id of the tag to add.
+ * @return true if the tag was inserted; false if the tag already existed.
+ */
+bool Item::addTagId(TagId tag) {
+    if (!tags.add(tag)) {
         return false;
     }
-    tags.push_back(tag);
+    if (owner != nullptr) {
+        owner->itemTagAdded(*this, tag);
+    }
+    modified();
     return true;
 }
 
@@ -95,12 +284,15 @@ bool Item::addTag(const std::string& tag) {
  * @return true if the tag was successfully deleted.
  * @throws std::out_of_range if the tag does not exist.
  */
-bool Item::deleteTag(const std::string& tag) {
-    auto it = std::find(tags.begin(), tags.end(), tag);
-    if (it == tags.end()) {
+bool Item::deleteTag(std::string_view tag) {
+    TagId id;
+    if (!TagDictionary::find(tag, id) || !tags.remove(id)) {
         throw std::out_of_range("Tag not found");
     }
-    tags.erase(it);
+    if (owner != nullptr) {
+        owner->itemTagDeleted(*this, id);
+    }
+    modified();
     return true;
 }
 
@@ -121,16 +313,27 @@ unsigned int Item::numTags() const {
  * @param tag The tag string to check.
  * @return true if the tag exists in the item; false otherwise.
  */
-bool Item::containsTag(const std::string& tag) const {
-    return std::find(tags.begin(), tags.end(), tag) != tags.end();
+bool Item::containsTag(std::string_view tag) const {
+    TagId id;
+    return TagDictionary::find(tag, id) && tags.contains(id);
+}
+
+/**
+ * @brief Checks whether the item contains a tag, by its id.
+ *
+ * @param tag The id of the tag to check.
+ * @return true if the tag exists in the item; false otherwise.
+ */
+bool Item::containsTagId(TagId tag) const {
+    return tags.contains(tag);
 }
 
 /**
  * @brief Retrieves the monetary amount associated with the item.
  *
- * @return double The current amount of the item.
+ * @return Money The current amount of the item.
  */
-double Item::getAmount() const {
+Money Item::getAmount() const {
     return amount;
 }
 
@@ -139,8 +342,11 @@ double Item::getAmount() const {
  *
  * @param amt The new amount to be assigned.
  */
-void Item::setAmount(double amt) {
+void Item::setAmount(const Money& amt) {
+    const Money old = amount;
     amount = amt;
+    amountModified(old);
+    modified();
 }
 
 /**
@@ -159,6 +365,7 @@ Date Item::getDate() const {
  */
 void Item::setDate(const Date& d) {
     date = d;
+    modified();
 }
 
 /**
@@ -181,36 +388,38 @@ bool Item::operator==(const Item& other) const {
 /**
  * @brief Converts the Item object to its JSON representation.
  *
- * Constructs a JSON-formatted string containing the amount, date, description, and tags.
- * The amount is formatted with one decimal place if it is an exact integer.
- *
  * @return std::string The JSON string representing the item.
  */
 std::string Item::str() const {
-    std::ostringstream os;
-    os << "{";
-    os << "\"amount\":";
-    
-    // Check if 'amount' is an exact integer.
-    if (std::floor(amount) == amount) {
-        // If it's an integer, force one decimal place.
-        os << std::fixed << std::setprecision(1) << amount;
-    } else {
-        // Otherwise, print normally.
-        os << amount;
-    }
-    
-    os << ",";
-    os << "\"date\":\"" << date.str() << "\",";
-    os << "\"description\":\"" << description << "\",";
-    os << "\"tags\":[";
+    StringWriter out;
+    write(out);
+    return out.str();
+}
+
+/**
+ * @brief Writes the JSON representation of the Item.
+ *
+ * The JSON object contains the amount, date, description, and tags.
+ * The amount is formatted with one decimal place if it is a whole amount.
+ *
+ * @param out The Writer to write to.
+ */
+void Item::write(Writer& out) const {
+    out.write("{\"amount\":", 10);
+    amount.write(out);
+
+    out.write(",\"date\":\"", 9);
+    date.write(out);
+    out.write("\",\"description\":\"", 17);
+    out.write(description.data(), description.size());
+    out.write("\",\"tags\":[", 10);
     for (auto it = tags.begin(); it != tags.end(); ++it) {
-        os << "\"" << *it << "\"";
-        if (std::next(it) != tags.end()) {
-            os << ",";
+        if (it != tags.begin()) {
+            out.put(',');
         }
+        out.put('"');
+        out.write(TagDictionary::name(*it));
+        out.put('"');
     }
-    os << "]";
-    os << "}";
-    return os.str();
+    out.write("]}", 2);
 }
@@ -8,50 +8,77 @@
 // -----------------------------------------------------
 // An Item class contains multiple 'tags' (e.g., a tag might be 'home' and
 // another tag could be 'uni'). An Item also has a description (e.g. 'Costa
-// Coffee'), a double amount (e.g. 2.55), and date associated with it. 
+// Coffee'), a Money amount (e.g. 2.55), and date associated with it. 
 // -----------------------------------------------------
 
 #ifndef ITEM_H
 #define ITEM_H
 
+#include "arena.h"
 #include "date.h"
+#include "money.h"
+#include "tags.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 
+class Category;
 
 class Item 
 {
+    friend class Category;
+
 private:
+        // The Category holding this item, told about every change to it.
+        Category* owner;
         std::string identifier;
-        std::string description;
-        double amount;
+        // In the Arena of the Category that created the item, if any.
+        ArenaString description;
+        Money amount;
         Date date;
         //std::set<std::string> tags; 
-        std::vector<std::string> tags;
+        TagList tags;
+
+    void modified();
+    void amountModified(const Money& old);
+    bool canMoveInto(const Arena* arena) const;
+
+    Item(const std::string& id, const std::string& desc, const Money& amt, const Date& d,
+         Arena* arena);
+    Item(const Item& other, Arena* arena);
 public:
 
+    Item(const std::string& id, const std::string& desc, const Money& amt, const Date& d);
     Item(const std::string& id, const std::string& desc, double amt, const Date& d);
+    Item(const Item& other);
+    Item(Item&& other) noexcept;
+    Item& operator=(const Item& other);
+    Item& operator=(Item&& other);
 
-    std::string getIdent() const;
-    std::string getDescription() const;
+    const std::string& getIdent() const;
+    std::string_view getDescription() const;
 
-    void setDescription(const std::string& desc);
+    void setDescription(std::string_view desc);
 
-    const std::vector<std::string>& getTags() const; //
-    bool addTag(const std::string& tag);
-    bool deleteTag(const std::string& tag);
+    TagNames getTags() const; //
+    const TagList& getTagIds() const;
+    bool addTag(std::string_view tag);
+    bool addTagId(TagId tag);
+    bool deleteTag(std::string_view tag);
     unsigned int numTags() const;
-    bool containsTag(const std::string& tag) const;
+    bool containsTag(std::string_view tag) const;
+    bool containsTagId(TagId tag) const;
 
-    double getAmount() const;
-    void setAmount(double amt);
+    Money getAmount() const;
+    void setAmount(const Money& amt);
     Date getDate() const;
     void setDate(const Date& d);
 
     bool operator==(const Item& other) const;
 
     std::string str() const;
+    void write(Writer& out) const;
 };
 
 #endif // ITEM_H
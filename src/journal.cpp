@@ -0,0 +1,275 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "journal.h"
+#include "expensetracker.h"
+#include "lib_json.hpp"
+#include <fstream>
+#include <cstdio>
+#include <stdexcept>
+#include <sys/stat.h>
+
+/**
+ * @brief Constructs a Journal for the database stored at the given path.
+ *
+ * Nothing is read or written until replay, commit or discard is called.
+ *
+ * @param db The path of the database snapshot the journal belongs to.
+ */
+Journal::Journal(const std::string& db) : dbPath(db), path(pathFor(db)) {}
+
+/**
+ * @brief Returns the path of the journal belonging to a database.
+ *
+ * @param db The path of the database snapshot.
+ * @return std::string The journal path, '<db>.journal'.
+ */
+std::string Journal::pathFor(const std::string& db) {
+    return db + ".journal";
+}
+
+/**
+ * @brief Identifies the current version of a database snapshot by its size and modification time.
+ *
+ * The stamp is written at the top of the journal, so that a journal left over from
+ * an older snapshot (for example one replaced by another program) is not replayed over a newer one.
+ *
+ * @param db The path of the database snapshot.
+ * @return std::string The stamp, or an empty string if the snapshot does not exist.
+ */
+std::string Journal::snapshotStamp(const std::string& db) {
+    struct stat st;
+    if (stat(db.c_str(), &st) != 0) {
+        return "";
+    }
+#if defined(__linux__)
+    const long long nanos = st.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+    const long long nanos = st.st_mtimespec.tv_nsec;
+#else
+    const long long nanos = 0;
+#endif
+    return std::to_string(static_cast<long long>(st.st_size)) + ":" +
+           std::to_string(static_cast<long long>(st.st_mtime)) + "." + std::to_string(nanos);
+}
+
+/**
+ * @brief Records the creation of a category.
+ *
+ * @param c The category identifier.
+ */
+void Journal::newCategory(const std::string& c) {
+    pending.push_back(nlohmann::json{{"op", "newCategory"}, {"category", c}}.dump());
+}
+
+/**
+ * @brief Records the creation (or replacement) of an item.
+ *
+ * @param c The category identifier.
+ * @param id The item identifier.
+ * @param desc The item description.
+ * @param amt The item amount.
+ * @param d The item date.
+ */
+void Journal::newItem(const std::string& c, const std::string& id,
+                      const std::string& desc, const Money& amt, const Date& d) {
+    pending.push_back(nlohmann::json{{"op", "newItem"}, {"category", c}, {"item", id},
+                                     {"description", desc}, {"amount", amt.str()},
+                                     {"date", d.str()}}.dump());
+}
+
+/**
+ * @brief Records a change to an item's description.
+ *
+ * @param c The category identifier.
+ * @param id The item identifier.
+ * @param desc The new description.
+ */
+void Journal::setDescription(const std::string& c, const std::string& id, const std::string& desc) {
+    pending.push_back(nlohmann::json{{"op", "setDescription"}, {"category", c}, {"item", id},
+                                     {"description", desc}}.dump());
+}
+
+/**
+ * @brief Records a change to an item's amount.
+ *
+ * @param c The category identifier.
+ * @param id The item identifier.
+ * @param amt The new amount.
+ */
+void Journal::setAmount(const std::string& c, const std::string& id, const Money& amt) {
+    pending.push_back(nlohmann::json{{"op", "setAmount"}, {"category", c}, {"item", id},
+                                     {"amount", amt.str()}}.dump());
+}
+
+/**
+ * @brief Records a change to an item's date.
+ *
+ * @param c The category identifier.
+ * @param id The item identifier.
+ * @param d The new date.
+ */
+void Journal::setDate(const std::string& c, const std::string& id, const Date& d) {
+    pending.push_back(nlohmann::json{{"op", "setDate"}, {"category", c}, {"item", id},
+                                     {"date", d.str()}}.dump());
+}
+
+/**
+ * @brief Records a tag being added to an item.
+ *
+ * @param c The category identifier.
+ * @param id The item identifier.
+ * @param tag The tag added.
+ */
+void Journal::addTag(const std::string& c, const std::string& id, const std::string& tag) {
+    pending.push_back(nlohmann::json{{"op", "addTag"}, {"category", c}, {"item", id},
+                                     {"tag", tag}}.dump());
+}
+
+/**
+ * @brief Records a tag being removed from an item.
+ *
+ * @param c The category identifier.
+ * @param id The item identifier.
+ * @param tag The tag removed.
+ */
+void Journal::deleteTag(const std::string& c, const std::string& id, const std::string& tag) {
+    pending.push_back(nlohmann::json{{"op", "deleteTag"}, {"category", c}, {"item", id},
+                                     {"tag", tag}}.dump());
+}
+
+/**
+ * @brief Records the deletion of an item.
+ *
+ * @param c The category identifier.
+ * @param id The item identifier.
+ */
+void Journal::deleteItem(const std::string& c, const std::string& id) {
+    pending.push_back(nlohmann::json{{"op", "deleteItem"}, {"category", c}, {"item", id}}.dump());
+}
+
+/**
+ * @brief Records the deletion of a category.
+ *
+ * @param c The category identifier.
+ */
+void Journal::deleteCategory(const std::string& c) {
+    pending.push_back(nlohmann::json{{"op", "deleteCategory"}, {"category", c}}.dump());
+}
+
+/**
+ * @brief Returns the number of recorded changes that have not been committed yet.
+ *
+ * @return unsigned int The number of pending entries.
+ */
+unsigned int Journal::size() const {
+    return pending.size();
+}
+
+/**
+ * @brief Appends the recorded changes to the journal file.
+ *
+ * If there is no journal yet, or the existing one was written against a different
+ * version of the snapshot, a new journal is started. Otherwise the entries are
+ * appended, so the cost is independent of the size of the database.
+ *
+ * @throws std::runtime_error if the journal file cannot be written.
+ */
+void Journal::commit() {
+    if (pending.empty()) {
+        return;
+    }
+    const std::string header = nlohmann::json{{"snapshot", snapshotStamp(dbPath)}}.dump();
+    std::string existing;
+    std::ifstream in(path);
+    const bool append = in.is_open() && std::getline(in, existing) && existing == header;
+    in.close();
+
+    std::ofstream out(path, append ? std::ios::app : std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("File not found: " + path);
+    }
+    if (!append) {
+        out << header << '\n';
+    }
+    for (const auto& entry : pending) {
+        out << entry << '\n';
+    }
+    out.close();
+    pending.clear();
+}
+
+/**
+ * @brief Applies the changes in the journal file to an ExpenseTracker.
+ *
+ * Journals written against a different version of the snapshot are ignored, as is
+ * a final entry left incomplete by an interrupted write.
+ *
+ * @param et The ExpenseTracker loaded from the snapshot.
+ * @return unsigned int The number of entries applied.
+ * @throws std::runtime_error if an entry cannot be applied.
+ */
+unsigned int Journal::replay(ExpenseTracker& et) const {
+    std::ifstream in(path);
+    std::string line;
+    if (!in.is_open() || !std::getline(in, line) ||
+        line != nlohmann::json{{"snapshot", snapshotStamp(dbPath)}}.dump()) {
+        return 0;
+    }
+    unsigned int count = 0;
+    while (std::getline(in, line)) {
+        if (in.eof()) {
+            // No terminating newline, so the entry was not completely written.
+            break;
+        }
+        try {
+            const nlohmann::json entry = nlohmann::json::parse(line);
+            const std::string op = entry.at("op").get<std::string>();
+            const std::string c = entry.at("category").get<std::string>();
+            if (op == "newCategory") {
+                et.newCategory(c);
+            } else if (op == "deleteCategory") {
+                et.deleteCategory(c);
+            } else if (op == "newItem") {
+                et.getCategory(c).newItem(entry.at("item").get<std::string>(),
+                                          entry.at("description").get<std::string>(),
+                                          Money::parse(entry.at("amount").get<std::string>()),
+                                          Date(entry.at("date").get<std::string>()));
+            } else if (op == "deleteItem") {
+                et.getCategory(c).deleteItem(entry.at("item").get<std::string>());
+            } else {
+                Item& item = et.getCategory(c).getItem(entry.at("item").get<std::string>());
+                if (op == "setDescription") {
+                    item.setDescription(entry.at("description").get<std::string>());
+                } else if (op == "setAmount") {
+                    item.setAmount(Money::parse(entry.at("amount").get<std::string>()));
+                } else if (op == "setDate") {
+                    item.setDate(Date(entry.at("date").get<std::string>()));
+                } else if (op == "addTag") {
+                    item.addTag(entry.at("tag").get<std::string>());
+                } else if (op == "deleteTag") {
+                    item.deleteTag(entry.at("tag").get<std::string>());
+                } else {
+                    throw std::runtime_error("unknown operation " + op);
+                }
+            }
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Invalid journal entry in " + path + ": " + e.what());
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Removes the journal file, once its changes are part of a saved snapshot.
+ */
+void Journal::discard() const {
+    std::remove(path.c_str());
+}
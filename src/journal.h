@@ -0,0 +1,57 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// A Journal is an append-only log of changes made to a
+// database, kept next to it in '<db>.journal'. Appending
+// a change costs the same however large the database is.
+// Loading replays the journal over the snapshot, and a
+// full save folds it back in by removing it.
+// -----------------------------------------------------
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "date.h"
+#include "money.h"
+#include <string>
+#include <vector>
+
+class ExpenseTracker;
+
+class Journal
+{
+private:
+    std::string dbPath;
+    std::string path;
+    std::vector<std::string> pending;
+
+    static std::string snapshotStamp(const std::string& db);
+
+public:
+    Journal(const std::string& db);
+
+    static std::string pathFor(const std::string& db);
+
+    void newCategory(const std::string& c);
+    void newItem(const std::string& c, const std::string& id,
+                 const std::string& desc, const Money& amt, const Date& d);
+    void setDescription(const std::string& c, const std::string& id, const std::string& desc);
+    void setAmount(const std::string& c, const std::string& id, const Money& amt);
+    void setDate(const std::string& c, const std::string& id, const Date& d);
+    void addTag(const std::string& c, const std::string& id, const std::string& tag);
+    void deleteTag(const std::string& c, const std::string& id, const std::string& tag);
+    void deleteItem(const std::string& c, const std::string& id);
+    void deleteCategory(const std::string& c);
+
+    unsigned int size() const;
+    void commit();
+    unsigned int replay(ExpenseTracker& et) const;
+    void discard() const;
+};
+
+#endif // JOURNAL_H
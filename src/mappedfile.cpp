@@ -0,0 +1,175 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "mappedfile.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPEDFILE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Opens a file and makes its whole contents available through data().
+ *
+ * On POSIX systems the file is mapped read-only into memory. If mapping is not
+ * supported, or fails (for example on an empty file or a pipe), the contents
+ * are read into an internal buffer instead.
+ *
+ * @param filename The path of the file to open.
+ * @throws std::runtime_error if the file cannot be opened or read.
+ */
+MappedFile::MappedFile(const std::string& filename)
+    : bytes(nullptr), length(0), mapped(false) {
+#ifdef MAPPEDFILE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("File not found: " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size),
+                            PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            ::madvise(addr, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+#endif
+            bytes = static_cast<const char*>(addr);
+            length = static_cast<std::size_t>(st.st_size);
+            mapped = true;
+            ::close(fd);
+            return;
+        }
+    }
+    ::close(fd);
+#endif
+    readAll(filename);
+}
+
+/**
+ * @brief Move constructor, taking over the mapping or buffer of another MappedFile.
+ *
+ * @param other The MappedFile to move from; it is left empty.
+ */
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : bytes(other.bytes), length(other.length), mapped(other.mapped),
+      buffer(std::move(other.buffer)) {
+    if (!mapped) {
+        bytes = buffer.data();
+    }
+    other.bytes = nullptr;
+    other.length = 0;
+    other.mapped = false;
+}
+
+/**
+ * @brief Move assignment, releasing the current contents first.
+ *
+ * @param other The MappedFile to move from; it is left empty.
+ * @return MappedFile& Reference to this object.
+ */
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        bytes = other.bytes;
+        length = other.length;
+        mapped = other.mapped;
+        buffer = std::move(other.buffer);
+        if (!mapped) {
+            bytes = buffer.data();
+        }
+        other.bytes = nullptr;
+        other.length = 0;
+        other.mapped = false;
+    }
+    return *this;
+}
+
+/**
+ * @brief Unmaps the file, if it was mapped.
+ */
+MappedFile::~MappedFile() {
+    release();
+}
+
+/**
+ * @brief Reads the whole file into the internal buffer with a single bulk read.
+ *
+ * @param filename The path of the file to read.
+ * @throws std::runtime_error if the file cannot be opened or read.
+ */
+void MappedFile::readAll(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw std::runtime_error("File not found: " + filename);
+    }
+    std::streamoff end = file.tellg();
+    if (end > 0) {
+        buffer.resize(static_cast<std::size_t>(end));
+        file.seekg(0);
+        if (!file.read(&buffer[0], end)) {
+            throw std::runtime_error("Failed to read file: " + filename);
+        }
+    } else {
+        // Not seekable or empty, fall back to draining the stream.
+        file.clear();
+        file.seekg(0);
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    bytes = buffer.data();
+    length = buffer.size();
+}
+
+/**
+ * @brief Releases the mapping and buffer held by this object.
+ */
+void MappedFile::release() {
+#ifdef MAPPEDFILE_MMAP
+    if (mapped) {
+        ::munmap(const_cast<char*>(bytes), length);
+    }
+#endif
+    bytes = nullptr;
+    length = 0;
+    mapped = false;
+    buffer.clear();
+}
+
+/**
+ * @brief Returns a pointer to the first byte of the file contents.
+ *
+ * @return const char* The contents; valid for size() bytes while this object lives.
+ */
+const char* MappedFile::data() const {
+    return bytes;
+}
+
+/**
+ * @brief Returns the size of the file contents in bytes.
+ *
+ * @return std::size_t The number of bytes available through data().
+ */
+std::size_t MappedFile::size() const {
+    return length;
+}
+
+/**
+ * @brief Reports whether the contents are memory mapped or were read into a buffer.
+ *
+ * @return true if the file is memory mapped.
+ */
+bool MappedFile::isMapped() const {
+    return mapped;
+}
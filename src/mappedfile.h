@@ -0,0 +1,45 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// A MappedFile gives read-only access to the whole contents
+// of a file as one contiguous block of bytes. Where mmap is
+// available the file is mapped into memory, otherwise it is
+// read into a buffer with a single bulk read.
+// -----------------------------------------------------
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+class MappedFile
+{
+private:
+    const char* bytes;
+    std::size_t length;
+    bool mapped;
+    std::string buffer;
+
+    void readAll(const std::string& filename);
+    void release();
+
+public:
+    MappedFile(const std::string& filename);
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    const char* data() const;
+    std::size_t size() const;
+    bool isMapped() const;
+};
+
+#endif // MAPPEDFILE_H
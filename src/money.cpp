@@ -0,0 +1,293 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "money.h"
+#include "writer.h"
+
+#include <cmath>
+#include <limits>
+
+// The number of units in one whole amount, e.g. pence in a pound.
+static const std::int64_t UNITS_PER_WHOLE = 100;
+
+/**
+ * @brief Constructs a Money object holding zero.
+ */
+Money::Money() : units(0) {}
+
+/**
+ * @brief Constructs a Money object from a floating-point amount.
+ *
+ * The amount is rounded to the nearest hundredth.
+ *
+ * @param amount The amount, e.g. 2.55.
+ * @throws std::out_of_range if the amount is not finite or too large to hold.
+ */
+Money::Money(double amount) {
+    const double scaled = std::round(amount * UNITS_PER_WHOLE);
+    if (!(std::fabs(scaled) < 9.2e18)) {
+        throw std::out_of_range("Amount out of range");
+    }
+    units = static_cast<std::int64_t>(scaled);
+}
+
+/**
+ * @brief Creates a Money object from a number of hundredths.
+ *
+ * @param units The amount in hundredths, e.g. 255 for 2.55.
+ * @return Money The amount.
+ */
+Money Money::fromUnits(std::int64_t units) {
+    Money m;
+    m.units = units;
+    return m;
+}
+
+/**
+ * @brief Parses a decimal amount exactly, without going through a double.
+ *
+ * Accepts an optional sign, digits with an optional decimal point, and an optional
+ * exponent, i.e. any JSON number (e.g. "2.55", "-3", "1.5e+03"). Trailing zeros
+ * beyond the hundredths are allowed (e.g. "2.550"), but no other digits are.
+ *
+ * @param text The amount as text.
+ * @return Money The amount.
+ * @throws std::invalid_argument if the text is not a number, or has a nonzero digit
+ * beyond the hundredths (e.g. "2.555").
+ * @throws std::out_of_range if the amount is too large to hold.
+ */
+Money Money::parse(const std::string& text) {
+    const std::size_t n = text.size();
+    std::size_t i = 0;
+    bool negative = false;
+    if (i < n && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        i++;
+    }
+
+    std::string digits;
+    long exponent = 0;
+    while (i < n && text[i] >= '0' && text[i] <= '9') {
+        digits += text[i++];
+    }
+    if (i < n && text[i] == '.') {
+        for (i++; i < n && text[i] >= '0' && text[i] <= '9'; i++) {
+            digits += text[i];
+            exponent--;
+        }
+    }
+    if (digits.empty()) {
+        throw std::invalid_argument("Invalid amount: " + text);
+    }
+    if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+        i++;
+        bool negativeExponent = false;
+        if (i < n && (text[i] == '-' || text[i] == '+')) {
+            negativeExponent = text[i] == '-';
+            i++;
+        }
+        if (i == n) {
+            throw std::invalid_argument("Invalid amount: " + text);
+        }
+        long e = 0;
+        for (; i < n && text[i] >= '0' && text[i] <= '9'; i++) {
+            if (e < 1000000) {
+                e = e * 10 + (text[i] - '0');
+            }
+        }
+        exponent += negativeExponent ? -e : e;
+    }
+    if (i != n) {
+        throw std::invalid_argument("Invalid amount: " + text);
+    }
+
+    // The value is digits * 10^exponent; in hundredths that is digits * 10^(exponent + 2).
+    // Digits from position 'whole' onwards are below one hundredth, so must all be zero.
+    digits.erase(0, digits.find_first_not_of('0'));
+    if (digits.empty()) {
+        return Money();
+    }
+    exponent += 2;
+    const long whole = static_cast<long>(digits.size()) + exponent;
+    if (digits.find_first_not_of('0', whole < 0 ? 0 : whole) != std::string::npos) {
+        throw std::invalid_argument("Invalid amount: more than two decimal places: " + text);
+    }
+    if (whole > 19) {
+        throw std::out_of_range("Amount out of range: " + text);
+    }
+    const std::uint64_t limit = std::numeric_limits<std::int64_t>::max();
+    std::uint64_t magnitude = 0;
+    for (long k = 0; k < whole; k++) {
+        const unsigned int digit = k < static_cast<long>(digits.size()) ? digits[k] - '0' : 0;
+        if (magnitude > (limit - digit) / 10) {
+            throw std::out_of_range("Amount out of range: " + text);
+        }
+        magnitude = magnitude * 10 + digit;
+    }
+
+    const std::int64_t value = static_cast<std::int64_t>(magnitude);
+    return fromUnits(negative ? -value : value);
+}
+
+/**
+ * @brief Gets the amount in hundredths.
+ *
+ * @return std::int64_t The amount in hundredths.
+ */
+std::int64_t Money::getUnits() const {
+    return units;
+}
+
+/**
+ * @brief Gets the amount as a floating-point number, e.g. 2.55.
+ *
+ * @return double The nearest double to the amount.
+ */
+double Money::toDouble() const {
+    return static_cast<double>(units) / UNITS_PER_WHOLE;
+}
+
+/**
+ * @brief Adds another amount to this one.
+ *
+ * @param other The amount to add.
+ * @return Money& This amount.
+ */
+Money& Money::operator+=(const Money& other) {
+    units += other.units;
+    return *this;
+}
+
+/**
+ * @brief Subtracts another amount from this one.
+ *
+ * @param other The amount to subtract.
+ * @return Money& This amount.
+ */
+Money& Money::operator-=(const Money& other) {
+    units -= other.units;
+    return *this;
+}
+
+/**
+ * @brief Adds two amounts.
+ *
+ * @param other The amount to add.
+ * @return Money The sum.
+ */
+Money Money::operator+(const Money& other) const {
+    return fromUnits(units + other.units);
+}
+
+/**
+ * @brief Subtracts one amount from another.
+ *
+ * @param other The amount to subtract.
+ * @return Money The difference.
+ */
+Money Money::operator-(const Money& other) const {
+    return fromUnits(units - other.units);
+}
+
+/**
+ * @brief Compares this amount with another for equality.
+ *
+ * @param other The amount to compare against.
+ * @return true if both amounts are equal, false otherwise.
+ */
+bool Money::operator==(const Money& other) const {
+    return units == other.units;
+}
+
+/**
+ * @brief Compares this amount with another for inequality.
+ *
+ * @param other The amount to compare against.
+ * @return true if the amounts differ, false otherwise.
+ */
+bool Money::operator!=(const Money& other) const {
+    return units != other.units;
+}
+
+/**
+ * @brief Compares this amount with a floating-point amount, rounded to the nearest hundredth.
+ *
+ * @param other The amount to compare against, e.g. 2.55.
+ * @return true if both amounts are equal, false otherwise.
+ * @throws std::out_of_range if the other amount is not finite or too large to hold.
+ */
+bool Money::operator==(double other) const {
+    return *this == Money(other);
+}
+
+/**
+ * @brief Compares this amount with a floating-point amount, rounded to the nearest hundredth,
+ * for inequality.
+ *
+ * @param other The amount to compare against, e.g. 2.55.
+ * @return true if the amounts differ, false otherwise.
+ * @throws std::out_of_range if the other amount is not finite or too large to hold.
+ */
+bool Money::operator!=(double other) const {
+    return *this != Money(other);
+}
+
+/**
+ * @brief Compares this amount with another to determine if it is smaller.
+ *
+ * @param other The amount to compare against.
+ * @return true if this amount is smaller than the other, false otherwise.
+ */
+bool Money::operator<(const Money& other) const {
+    return units < other.units;
+}
+
+/**
+ * @brief Returns the amount as it is written to JSON.
+ *
+ * @return std::string The amount, e.g. "2.55" or "164.0".
+ */
+std::string Money::str() const {
+    StringWriter out;
+    write(out);
+    return out.str();
+}
+
+/**
+ * @brief Writes the amount as a JSON number.
+ *
+ * Whole amounts get one decimal place ("164.0"); otherwise the hundredths are written
+ * without a trailing zero ("39.99", "0.5"). This is the text the amounts were written
+ * with when they were held as doubles.
+ *
+ * @param out The Writer to write to.
+ */
+void Money::write(Writer& out) const {
+    char text[24];
+    char* const end = text + sizeof(text);
+    char* p = end;
+
+    std::uint64_t magnitude = units < 0 ? 0 - static_cast<std::uint64_t>(units)
+                                        : static_cast<std::uint64_t>(units);
+    const unsigned int fraction = static_cast<unsigned int>(magnitude % UNITS_PER_WHOLE);
+    if (fraction % 10 != 0) {
+        *--p = static_cast<char>('0' + fraction % 10);
+    }
+    *--p = static_cast<char>('0' + fraction / 10);
+    *--p = '.';
+    magnitude /= UNITS_PER_WHOLE;
+    do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (units < 0) {
+        *--p = '-';
+    }
+    out.write(p, end - p);
+}
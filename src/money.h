@@ -0,0 +1,54 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// A Money class holds an amount as a whole number of
+// hundredths (e.g. 2.55 is held as 255), so adding up
+// amounts is exact and does not depend on the order the
+// amounts are added in.
+// -----------------------------------------------------
+
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+class Writer;
+
+class Money
+{
+private:
+    std::int64_t units;
+
+public:
+    Money();
+    explicit Money(double amount);
+
+    static Money fromUnits(std::int64_t units);
+    static Money parse(const std::string& text);
+
+    std::int64_t getUnits() const;
+    double toDouble() const;
+
+    Money& operator+=(const Money& other);
+    Money& operator-=(const Money& other);
+    Money operator+(const Money& other) const;
+    Money operator-(const Money& other) const;
+
+    bool operator==(const Money& other) const;
+    bool operator!=(const Money& other) const;
+    bool operator==(double other) const;
+    bool operator!=(double other) const;
+    bool operator<(const Money& other) const;
+
+    std::string str() const;
+    void write(Writer& out) const;
+};
+
+#endif // MONEY_H
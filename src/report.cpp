@@ -0,0 +1,368 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "report.h"
+#include "text.h"
+#include "writer.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Compares two group keys.
+ *
+ * @param other The key to compare against.
+ * @return true if both keys stand for the same group.
+ */
+bool Report::Key::operator==(const Key& other) const {
+    return month == other.month && category == other.category && tag == other.tag;
+}
+
+/**
+ * @brief Hashes a group key by packing it into 64 bits and mixing the bits.
+ *
+ * @param key The key to hash.
+ * @return std::size_t The hash.
+ */
+std::size_t Report::KeyHash::operator()(const Key& key) const {
+    const std::uint64_t packed = (std::uint64_t(key.month) << 32 | key.category) ^
+                                 (std::uint64_t(key.tag) << 20);
+    return static_cast<std::size_t>((packed * 0x9E3779B97F4A7C15ULL) >> 16);
+}
+
+/**
+ * @brief Returns the name of the tag of a group.
+ *
+ * @param tag The TagId of the tag, or TagDictionary::NONE for items without tags.
+ * @return const std::string& The tag, or an empty string for items without tags.
+ */
+static const std::string& tagName(TagId tag) {
+    static const std::string untagged;
+    return tag == TagDictionary::NONE ? untagged : TagDictionary::name(tag);
+}
+
+/**
+ * @brief Constructs the empty totals of a group.
+ */
+Report::Totals::Totals() : count(0), sum() {}
+
+/**
+ * @brief Constructs an empty Report.
+ *
+ * @param groupBy The dimensions to group by, in the order they are written and sorted by.
+ * @param tag If not empty, the only tag that items are grouped under when grouping by tag.
+ */
+Report::Report(const std::vector<Dimension>& groupBy, const std::string& tag)
+    : groupBy(groupBy), tagGiven(!tag.empty()), onlyTagName(tag), onlyTag(TagDictionary::NONE) {}
+
+/**
+ * @brief Parses a comma separated list of dimensions, such as "month,category,tag".
+ *
+ * @param list The list, in any case.
+ * @return std::vector<Report::Dimension> The dimensions, in the order given.
+ * @throws std::invalid_argument if the list is empty, or a dimension is unknown or repeated.
+ */
+std::vector<Report::Dimension> Report::parseGroupBy(const std::string& list) {
+    std::vector<Dimension> dimensions;
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        std::size_t end = list.find(',', begin);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string name = list.substr(begin, end - begin);
+        std::transform(name.begin(), name.end(), name.begin(), lower);
+        Dimension dimension;
+        if (name == "month") {
+            dimension = MONTH;
+        } else if (name == "category") {
+            dimension = CATEGORY;
+        } else if (name == "tag") {
+            dimension = TAG;
+        } else {
+            throw std::invalid_argument("group-by");
+        }
+        if (std::find(dimensions.begin(), dimensions.end(), dimension) != dimensions.end()) {
+            throw std::invalid_argument("group-by");
+        }
+        dimensions.push_back(dimension);
+        begin = end + 1;
+    }
+    return dimensions;
+}
+
+/**
+ * @brief Checks whether the report groups by a dimension.
+ *
+ * @param dimension The dimension.
+ * @return true if it is one of the dimensions grouped by.
+ */
+bool Report::groupsBy(Dimension dimension) const {
+    return std::find(groupBy.begin(), groupBy.end(), dimension) != groupBy.end();
+}
+
+/**
+ * @brief Finds the id standing for a category, giving it the next id if it has none.
+ *
+ * @param category The identifier of the category.
+ * @return std::uint32_t The id of the category.
+ */
+std::uint32_t Report::intern(const std::string& category) {
+    auto result = categoryIds.insert(std::make_pair(category, static_cast<std::uint32_t>(categories.size())));
+    if (result.second) {
+        categories.push_back(category);
+    }
+    return result.first->second;
+}
+
+/**
+ * @brief Adds items of a category to their groups.
+ *
+ * The items are visited once. When grouping by month, the month of the last item is
+ * remembered together with the serial days it spans, so items in date order, as
+ * returned by Category::getItems, only work out their month when it changes. When
+ * grouping by tag, an item is added to the group of each of its tags (or only of the
+ * tag given to the constructor), and an item without tags to the group of the empty tag
+ * unless a tag was given.
+ *
+ * @param c The Category the items belong to.
+ * @param selection The items to add.
+ */
+void Report::add(const Category& c, const std::vector<const Item*>& selection) {
+    if (selection.empty()) {
+        return;
+    }
+    const bool byMonth = groupsBy(MONTH);
+    const bool byTag = groupsBy(TAG);
+    if (tagGiven && onlyTag == TagDictionary::NONE) {
+        // Until an item carries the tag it has no id, and no item matches it.
+        TagDictionary::find(onlyTagName, onlyTag);
+    }
+    // Items tagged with the empty string are grouped with the untagged ones.
+    TagId emptyTag = TagDictionary::NONE;
+    if (byTag) {
+        TagDictionary::find("", emptyTag);
+    }
+    Key key{0, 0, 0};
+    if (groupsBy(CATEGORY)) {
+        key.category = intern(c.getIdent());
+    }
+
+    std::uint32_t monthBegin = 1;
+    std::uint32_t monthEnd = 0;
+    for (const Item* item : selection) {
+        if (byMonth) {
+            const Date& date = item->getDate();
+            const std::uint32_t serial = date.getSerial();
+            if (serial < monthBegin || serial >= monthEnd) {
+                const unsigned int year = date.getYear();
+                const unsigned int month = date.getMonth();
+                key.month = year * 12 + month - 1;
+                monthBegin = serial - (date.getDay() - 1);
+                if (month < 12) {
+                    monthEnd = Date(year, month + 1, 1).getSerial();
+                } else if (year < Date::latest().getYear()) {
+                    monthEnd = Date(year + 1, 1, 1).getSerial();
+                } else {
+                    monthEnd = Date::latest().getSerial() + 1;
+                }
+            }
+        }
+
+        if (!byTag) {
+            Totals& totals = groups[key];
+            totals.count++;
+            totals.sum += item->getAmount();
+            continue;
+        }
+        const TagList& itemTags = item->getTagIds();
+        if (itemTags.empty()) {
+            if (tagGiven) {
+                continue;
+            }
+            key.tag = TagDictionary::NONE;
+            Totals& totals = groups[key];
+            totals.count++;
+            totals.sum += item->getAmount();
+            continue;
+        }
+        for (const TagId tag : itemTags) {
+            if (tagGiven && tag != onlyTag) {
+                continue;
+            }
+            key.tag = tag == emptyTag ? TagDictionary::NONE : tag;
+            Totals& totals = groups[key];
+            totals.count++;
+            totals.sum += item->getAmount();
+        }
+    }
+}
+
+/**
+ * @brief Adds the groups of another report, built with the same dimensions, to this one.
+ *
+ * @param other The other report.
+ */
+void Report::merge(const Report& other) {
+    const bool byCategory = groupsBy(CATEGORY);
+    for (const auto& pair : other.groups) {
+        Key key = pair.first;
+        if (byCategory) {
+            key.category = intern(other.categories[key.category]);
+        }
+        Totals& totals = groups[key];
+        totals.count += pair.second.count;
+        totals.sum += pair.second.sum;
+    }
+}
+
+/**
+ * @brief Returns the number of groups.
+ *
+ * @return std::size_t The number of groups with at least one item.
+ */
+std::size_t Report::size() const {
+    return groups.size();
+}
+
+/**
+ * @brief Returns the groups sorted by the dimensions grouped by, in order.
+ *
+ * Months sort by date, categories and tags by name.
+ *
+ * @return std::vector<std::pair<Key, Totals>> The sorted groups.
+ */
+std::vector<std::pair<Report::Key, Report::Totals>> Report::sorted() const {
+    std::vector<std::pair<Key, Totals>> rows(groups.begin(), groups.end());
+    std::sort(rows.begin(), rows.end(), [this](const std::pair<Key, Totals>& a,
+                                               const std::pair<Key, Totals>& b) {
+        for (Dimension dimension : groupBy) {
+            if (dimension == MONTH && a.first.month != b.first.month) {
+                return a.first.month < b.first.month;
+            }
+            if (dimension == CATEGORY && a.first.category != b.first.category) {
+                return categories[a.first.category] < categories[b.first.category];
+            }
+            if (dimension == TAG && a.first.tag != b.first.tag) {
+                return tagName(a.first.tag) < tagName(b.first.tag);
+            }
+        }
+        return false;
+    });
+    return rows;
+}
+
+/**
+ * @brief Writes the value of one dimension of a group.
+ *
+ * Months are written as "YYYY-MM". In JSON, names are written as strings; in CSV,
+ * names containing commas, quotes or line breaks are quoted.
+ *
+ * @param out The Writer to write to.
+ * @param dimension The dimension.
+ * @param key The group.
+ * @param csv Whether to write CSV rather than JSON.
+ */
+void Report::writeField(Writer& out, Dimension dimension, const Key& key, bool csv) const {
+    if (dimension == MONTH) {
+        const unsigned int year = key.month / 12;
+        const unsigned int month = key.month % 12 + 1;
+        if (!csv) {
+            out.put('"');
+        }
+        if (year > 9999) {
+            out.write(std::to_string(year));
+        } else {
+            const char text[4] = {static_cast<char>('0' + year / 1000), static_cast<char>('0' + year / 100 % 10),
+                                  static_cast<char>('0' + year / 10 % 10), static_cast<char>('0' + year % 10)};
+            out.write(text, sizeof(text));
+        }
+        const char text[3] = {'-', static_cast<char>('0' + month / 10), static_cast<char>('0' + month % 10)};
+        out.write(text, sizeof(text));
+        if (!csv) {
+            out.put('"');
+        }
+        return;
+    }
+
+    const std::string& name =
+        dimension == CATEGORY ? categories[key.category] : tagName(key.tag);
+    if (!csv) {
+        out.put('"');
+        out.write(name);
+        out.put('"');
+    } else if (name.find_first_of(",\"\r\n") == std::string::npos) {
+        out.write(name);
+    } else {
+        out.put('"');
+        for (char ch : name) {
+            if (ch == '"') {
+                out.put('"');
+            }
+            out.put(ch);
+        }
+        out.put('"');
+    }
+}
+
+/**
+ * @brief Writes the groups as a JSON array, with one object per group holding its
+ * dimensions, count and sum, e.g. [{"month":"2024-12","count":3,"sum":1203.98}].
+ *
+ * @param out The Writer to write to.
+ */
+void Report::write(Writer& out) const {
+    static const char* names[] = {"month", "category", "tag"};
+    out.put('[');
+    bool first = true;
+    for (const auto& row : sorted()) {
+        if (!first) {
+            out.put(',');
+        }
+        first = false;
+        out.put('{');
+        for (Dimension dimension : groupBy) {
+            out.put('"');
+            out.write(names[dimension]);
+            out.write("\":", 2);
+            writeField(out, dimension, row.first, false);
+            out.put(',');
+        }
+        out.write("\"count\":", 8);
+        out.write(std::to_string(row.second.count));
+        out.write(",\"sum\":", 7);
+        row.second.sum.write(out);
+        out.put('}');
+    }
+    out.put(']');
+}
+
+/**
+ * @brief Writes the groups as CSV, with a header line and one line per group holding
+ * its dimensions, count and sum.
+ *
+ * @param out The Writer to write to.
+ */
+void Report::writeCsv(Writer& out) const {
+    static const char* names[] = {"month", "category", "tag"};
+    for (Dimension dimension : groupBy) {
+        out.write(names[dimension]);
+        out.put(',');
+    }
+    out.write("count,sum\n", 10);
+    for (const auto& row : sorted()) {
+        for (Dimension dimension : groupBy) {
+            writeField(out, dimension, row.first, true);
+            out.put(',');
+        }
+        out.write(std::to_string(row.second.count));
+        out.put(',');
+        row.second.sum.write(out);
+        out.put('\n');
+    }
+}
@@ -0,0 +1,89 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// A Report groups expenses by any of month, category and
+// tag, and holds the count and sum of the amounts in each
+// group. Items are added a category at a time in a single
+// pass, into a hash table keyed on the month and on ids
+// standing for the category and tag. Reports built for
+// different categories can be merged, and the groups are
+// written out as JSON or CSV.
+// -----------------------------------------------------
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "category.h"
+
+class Writer;
+
+class Report
+{
+public:
+    enum Dimension { MONTH, CATEGORY, TAG };
+
+private:
+    // A group: the month as year * 12 + month - 1, the position of the category
+    // in categories, and the TagId of the tag, or TagDictionary::NONE for items
+    // without tags. Dimensions not grouped by are 0.
+    struct Key
+    {
+        std::uint32_t month;
+        std::uint32_t category;
+        std::uint32_t tag;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Totals
+    {
+        std::uint64_t count;
+        Money sum;
+
+        Totals();
+    };
+
+    std::vector<Dimension> groupBy;
+    bool tagGiven;
+    // The tag given, and its id, or TagDictionary::NONE until it is found.
+    std::string onlyTagName;
+    TagId onlyTag;
+    std::vector<std::string> categories;
+    std::unordered_map<std::string, std::uint32_t> categoryIds;
+    std::unordered_map<Key, Totals, KeyHash> groups;
+
+    bool groupsBy(Dimension dimension) const;
+    std::uint32_t intern(const std::string& category);
+    std::vector<std::pair<Key, Totals>> sorted() const;
+    void writeField(Writer& out, Dimension dimension, const Key& key, bool csv) const;
+
+public:
+    Report(const std::vector<Dimension>& groupBy, const std::string& tag = "");
+
+    static std::vector<Dimension> parseGroupBy(const std::string& list);
+
+    void add(const Category& c, const std::vector<const Item*>& selection);
+    void merge(const Report& other);
+    std::size_t size() const;
+
+    void write(Writer& out) const;
+    void writeCsv(Writer& out) const;
+};
+
+#endif // REPORT_H
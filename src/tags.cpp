@@ -0,0 +1,238 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "tags.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// The strings are kept in chunks that are never moved or freed, so name() can
+// read them without taking the lock: a thread can only hold an id once the
+// string for it has been stored. For the same reason ids can be keyed by views
+// of the stored strings, so that looking a tag up copies nothing.
+const std::size_t CHUNK_BITS = 10;
+const std::size_t CHUNK_SIZE = std::size_t(1) << CHUNK_BITS;
+const std::size_t MAX_CHUNKS = 4096;
+
+struct Store
+{
+    std::mutex mutex;
+    std::unordered_map<std::string_view, TagId> ids;
+    std::unique_ptr<std::string[]> chunks[MAX_CHUNKS];
+};
+
+Store& store() {
+    static Store instance;
+    return instance;
+}
+
+} // namespace
+
+const TagId TagDictionary::NONE;
+
+/**
+ * @brief Returns the id of a tag, giving it the next id if it has none.
+ *
+ * @param tag The tag.
+ * @return TagId The id of the tag.
+ * @throws std::length_error if there are too many different tags.
+ */
+TagId TagDictionary::intern(std::string_view tag) {
+    Store& s = store();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.ids.find(tag);
+    if (it != s.ids.end()) {
+        return it->second;
+    }
+    const std::size_t id = s.ids.size();
+    const std::size_t chunk = id >> CHUNK_BITS;
+    if (chunk >= MAX_CHUNKS) {
+        throw std::length_error("Too many tags");
+    }
+    if (!s.chunks[chunk]) {
+        s.chunks[chunk].reset(new std::string[CHUNK_SIZE]);
+    }
+    std::string& stored = s.chunks[chunk][id & (CHUNK_SIZE - 1)];
+    stored.assign(tag.data(), tag.size());
+    s.ids.insert(std::make_pair(std::string_view(stored), static_cast<TagId>(id)));
+    return static_cast<TagId>(id);
+}
+
+/**
+ * @brief Finds the id of a tag without giving it one if it has none.
+ *
+ * A tag without an id is carried by no item.
+ *
+ * @param tag The tag.
+ * @param id Receives the id of the tag, if it has one.
+ * @return true if the tag has an id.
+ */
+bool TagDictionary::find(std::string_view tag, TagId& id) {
+    Store& s = store();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.ids.find(tag);
+    if (it == s.ids.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+/**
+ * @brief Returns the tag with an id.
+ *
+ * @param id An id given out by intern.
+ * @return const std::string& The tag, which stays valid until the process ends.
+ */
+const std::string& TagDictionary::name(TagId id) {
+    return store().chunks[id >> CHUNK_BITS][id & (CHUNK_SIZE - 1)];
+}
+
+/**
+ * @brief Returns the number of different tags seen.
+ *
+ * @return std::size_t The number of tags with an id.
+ */
+std::size_t TagDictionary::size() {
+    Store& s = store();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.ids.size();
+}
+
+/**
+ * @brief Constructs an empty TagList.
+ */
+TagList::TagList() : count(0), local() {}
+
+/**
+ * @brief Moves a list, taking its vector rather than copying it. The list moved from is left empty.
+ *
+ * @param other The list to move from.
+ */
+TagList::TagList(TagList&& other) noexcept : count(other.count), spill(std::move(other.spill)) {
+    std::copy(other.local, other.local + LOCAL, local);
+    other.count = 0;
+}
+
+/**
+ * @brief Move assigns a list, taking its vector rather than copying it. The list moved
+ * from is left empty.
+ *
+ * @param other The list to move from.
+ * @return TagList& This list.
+ */
+TagList& TagList::operator=(TagList&& other) noexcept {
+    if (this != &other) {
+        count = other.count;
+        std::copy(other.local, other.local + LOCAL, local);
+        spill = std::move(other.spill);
+        other.count = 0;
+        other.spill.clear();
+    }
+    return *this;
+}
+
+/**
+ * @brief Checks whether the list holds an id.
+ *
+ * @param id The id.
+ * @return true if the id is in the list.
+ */
+bool TagList::contains(TagId id) const {
+    return std::find(begin(), end(), id) != end();
+}
+
+/**
+ * @brief Adds an id to the end of the list, moving the ids to the vector when
+ * they no longer fit in the object.
+ *
+ * @param id The id.
+ * @return true if the id was added; false if it was already in the list.
+ */
+bool TagList::add(TagId id) {
+    if (contains(id)) {
+        return false;
+    }
+    if (count < LOCAL) {
+        local[count] = id;
+    } else {
+        if (count == LOCAL) {
+            spill.assign(local, local + LOCAL);
+        }
+        spill.push_back(id);
+    }
+    count++;
+    return true;
+}
+
+/**
+ * @brief Removes an id from the list, keeping the order of the others, and moves
+ * the ids back into the object when they fit again.
+ *
+ * @param id The id.
+ * @return true if the id was removed; false if it was not in the list.
+ */
+bool TagList::remove(TagId id) {
+    if (count <= LOCAL) {
+        TagId* last = local + count;
+        TagId* it = std::find(local, last, id);
+        if (it == last) {
+            return false;
+        }
+        std::copy(it + 1, last, it);
+    } else {
+        auto it = std::find(spill.begin(), spill.end(), id);
+        if (it == spill.end()) {
+            return false;
+        }
+        spill.erase(it);
+        if (spill.size() == LOCAL) {
+            std::copy(spill.begin(), spill.end(), local);
+            std::vector<TagId>().swap(spill);
+        }
+    }
+    count--;
+    return true;
+}
+
+/**
+ * @brief Compares two lists.
+ *
+ * @param other The list to compare against.
+ * @return true if both hold the same ids in the same order.
+ */
+bool TagList::operator==(const TagList& other) const {
+    return count == other.count && std::equal(begin(), end(), other.begin());
+}
+
+/**
+ * @brief Compares two views.
+ *
+ * @param other The view to compare against.
+ * @return true if both hold the same tags in the same order.
+ */
+bool TagNames::operator==(const TagNames& other) const {
+    return size() == other.size() && std::equal(first, last, other.first);
+}
+
+/**
+ * @brief Compares the view with a vector of tag strings.
+ *
+ * @param other The tags to compare against.
+ * @return true if both hold the same tags in the same order.
+ */
+bool TagNames::operator==(const std::vector<std::string>& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
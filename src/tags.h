@@ -0,0 +1,121 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Tags are interned: the TagDictionary holds each tag
+// string once and gives it a small integer TagId, and an
+// Item keeps the ids of its tags in a TagList, which has
+// room for a few ids without allocating. TagNames views a
+// TagList as the tag strings.
+// -----------------------------------------------------
+
+#ifndef TAGS_H
+#define TAGS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+typedef std::uint32_t TagId;
+
+// The ids of all tags in this process. Items are copied between categories and
+// trackers, so the dictionary is shared by all of them rather than owned by an
+// ExpenseTracker, and a tag keeps its id (and its string) until the process ends.
+// Ids are given out in the order tags are first seen. It is safe to use from
+// several threads. Queries should look tags up with find rather than intern, so
+// that tags no item carries are not kept; NONE is an id no tag is ever given.
+class TagDictionary
+{
+public:
+    static const TagId NONE = 0xFFFFFFFF;
+
+    static TagId intern(std::string_view tag);
+    static bool find(std::string_view tag, TagId& id);
+    static const std::string& name(TagId id);
+    static std::size_t size();
+};
+
+// The ids of the tags of an item, in the order they were added. Up to LOCAL ids
+// are kept in the object itself, and more in a vector.
+class TagList
+{
+private:
+    static const std::size_t LOCAL = 4;
+
+    std::uint32_t count;
+    TagId local[LOCAL];
+    std::vector<TagId> spill;
+
+public:
+    TagList();
+    TagList(const TagList& other) = default;
+    TagList(TagList&& other) noexcept;
+    TagList& operator=(const TagList& other) = default;
+    TagList& operator=(TagList&& other) noexcept;
+
+    const TagId* begin() const { return count <= LOCAL ? local : spill.data(); }
+    const TagId* end() const { return begin() + count; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    bool contains(TagId id) const;
+    bool add(TagId id);
+    bool remove(TagId id);
+
+    bool operator==(const TagList& other) const;
+    bool operator!=(const TagList& other) const { return !(*this == other); }
+};
+
+// A view of a TagList as the tag strings, valid while the TagList is unchanged.
+class TagNames
+{
+private:
+    const TagId* first;
+    const TagId* last;
+
+public:
+    class const_iterator
+    {
+    private:
+        const TagId* id;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::string value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string* pointer;
+        typedef const std::string& reference;
+
+        explicit const_iterator(const TagId* id) : id(id) {}
+
+        const std::string& operator*() const { return TagDictionary::name(*id); }
+        const std::string* operator->() const { return &TagDictionary::name(*id); }
+        const_iterator& operator++() { ++id; return *this; }
+        const_iterator operator++(int) { const_iterator old(*this); ++id; return old; }
+        bool operator==(const const_iterator& other) const { return id == other.id; }
+        bool operator!=(const const_iterator& other) const { return id != other.id; }
+    };
+    typedef const_iterator iterator;
+    typedef std::string value_type;
+
+    explicit TagNames(const TagList& tags) : first(tags.begin()), last(tags.end()) {}
+
+    const_iterator begin() const { return const_iterator(first); }
+    const_iterator end() const { return const_iterator(last); }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+    const std::string& operator[](std::size_t i) const { return TagDictionary::name(first[i]); }
+
+    bool operator==(const TagNames& other) const;
+    bool operator!=(const TagNames& other) const { return !(*this == other); }
+    bool operator==(const std::vector<std::string>& other) const;
+};
+
+#endif // TAGS_H
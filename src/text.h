@@ -0,0 +1,32 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Helpers for text that is compared ignoring case, such
+// as descriptions, program argument values, and the names
+// in filter expressions and reports.
+// -----------------------------------------------------
+
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <cctype>
+
+/**
+ * @brief Lowercases a character.
+ *
+ * The character is passed to std::tolower as an unsigned char, as passing a negative
+ * char (a byte of a UTF-8 sequence) is undefined behaviour.
+ *
+ * @param c The character.
+ * @return char The character in lower case, if it is an ASCII letter.
+ */
+inline char lower(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+#endif // TEXT_H
@@ -0,0 +1,122 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "threadpool.h"
+
+/**
+ * @brief Constructs a ThreadPool and starts its worker threads.
+ *
+ * The calling thread of run counts as one of the threads, so one fewer worker
+ * is started.
+ *
+ * @param threads The number of threads to run tasks on, or 0 for one per hardware thread.
+ */
+ThreadPool::ThreadPool(unsigned int threads)
+    : task(nullptr), tasks(0), next(0), done(0), batch(0), stopping(false) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    for (unsigned int i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+/**
+ * @brief Stops and joins the worker threads.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Returns the number of threads tasks are run on, including the caller of run.
+ *
+ * @return unsigned int The number of threads.
+ */
+unsigned int ThreadPool::size() const {
+    return workers.size() + 1;
+}
+
+/**
+ * @brief Runs the tasks numbered 0 to count - 1 and waits for all of them to finish.
+ *
+ * Tasks are handed out in order to whichever thread is free, so fn must be safe
+ * to call from several threads at once for different task numbers. If tasks
+ * throw, every task is still run and then the exception of the lowest numbered
+ * failing task is rethrown, so which exception is seen does not depend on timing.
+ *
+ * @param count The number of tasks.
+ * @param fn The task, called with each task number.
+ */
+void ThreadPool::run(std::size_t count, const std::function<void(std::size_t)>& fn) {
+    std::lock_guard<std::mutex> serial(running);
+    std::unique_lock<std::mutex> lock(mutex);
+    task = &fn;
+    tasks = count;
+    next = 0;
+    done = 0;
+    errors.assign(count, std::exception_ptr());
+    batch++;
+    started.notify_all();
+
+    runTasks(lock);
+    finished.wait(lock, [this] { return done == tasks; });
+    task = nullptr;
+    for (const auto& error : errors) {
+        if (error) {
+            std::exception_ptr first = error;
+            errors.clear();
+            std::rethrow_exception(first);
+        }
+    }
+}
+
+/**
+ * @brief Runs tasks of the current batch until none are left to start.
+ *
+ * @param lock The lock on mutex, held on entry and exit but not while a task runs.
+ */
+void ThreadPool::runTasks(std::unique_lock<std::mutex>& lock) {
+    while (next < tasks) {
+        const std::size_t i = next++;
+        lock.unlock();
+        try {
+            (*task)(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+        lock.lock();
+        if (++done == tasks) {
+            finished.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief The loop of a worker thread: waits for a batch, helps run it, and repeats until stopped.
+ */
+void ThreadPool::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    unsigned long seen = 0;
+    while (true) {
+        started.wait(lock, [this, seen] { return stopping || batch != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = batch;
+        runTasks(lock);
+    }
+}
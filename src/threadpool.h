@@ -0,0 +1,61 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// A ThreadPool runs a batch of numbered tasks on a fixed
+// number of threads, the calling thread being one of them,
+// and waits for all of them to finish. ExpenseTracker uses
+// one to work on its categories in parallel.
+// -----------------------------------------------------
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers;
+    // Serialises calls to run, which may come from copies of an ExpenseTracker
+    // sharing the pool.
+    std::mutex running;
+
+    // The batch being run, guarded by mutex: the task, how many tasks there are,
+    // the next one to start and how many have finished. batch changes whenever
+    // a new batch starts, so that waiting workers know to wake up.
+    std::mutex mutex;
+    std::condition_variable started;
+    std::condition_variable finished;
+    const std::function<void(std::size_t)>* task;
+    std::size_t tasks;
+    std::size_t next;
+    std::size_t done;
+    unsigned long batch;
+    bool stopping;
+    std::vector<std::exception_ptr> errors;
+
+    void work();
+    void runTasks(std::unique_lock<std::mutex>& lock);
+
+public:
+    ThreadPool(unsigned int threads);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    unsigned int size() const;
+    void run(std::size_t count, const std::function<void(std::size_t)>& fn);
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,189 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "top.h"
+#include "text.h"
+#include "writer.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Constructs an empty Top.
+ *
+ * @param by Whether expenses rank by amount, largest first, or by date, most recent first.
+ * @param limit The number of expenses to keep.
+ */
+Top::Top(Order by, std::size_t limit) : by(by), limit(limit) {}
+
+/**
+ * @brief Parses what expenses rank by: "amount" or "date".
+ *
+ * @param order The name, in any case.
+ * @return Top::Order The order.
+ * @throws std::invalid_argument if the name is unknown.
+ */
+Top::Order Top::parseOrder(const std::string& order) {
+    std::string name = order;
+    std::transform(name.begin(), name.end(), name.begin(), lower);
+    if (name == "amount") return AMOUNT;
+    if (name == "date") return DATE;
+    throw std::invalid_argument("by");
+}
+
+/**
+ * @brief Checks whether one expense ranks before another.
+ *
+ * Expenses rank by amount then date, or by date then amount, both descending. Ties
+ * rank by category and then item identifier, ascending, so the ranking is the same
+ * however the expenses are added.
+ *
+ * @param a The first expense.
+ * @param b The second expense.
+ * @return true if a ranks before b.
+ */
+bool Top::before(const Entry& a, const Entry& b) const {
+    const Money amountA = a.item->getAmount();
+    const Money amountB = b.item->getAmount();
+    const Date dateA = a.item->getDate();
+    const Date dateB = b.item->getDate();
+    if (by == AMOUNT) {
+        if (amountA != amountB) return amountB < amountA;
+        if (!(dateA == dateB)) return dateB < dateA;
+    } else {
+        if (!(dateA == dateB)) return dateB < dateA;
+        if (amountA != amountB) return amountB < amountA;
+    }
+    if (a.category != b.category) {
+        return a.category->getIdent() < b.category->getIdent();
+    }
+    return a.item->getIdent() < b.item->getIdent();
+}
+
+/**
+ * @brief Keeps an expense if fewer than limit are kept or it ranks before the lowest
+ * ranked of them, which it then replaces.
+ *
+ * @param entry The expense.
+ */
+void Top::offer(const Entry& entry) {
+    const auto compare = [this](const Entry& a, const Entry& b) { return before(a, b); };
+    if (heap.size() < limit) {
+        heap.push_back(entry);
+        std::push_heap(heap.begin(), heap.end(), compare);
+    } else if (limit > 0 && before(entry, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), compare);
+        heap.back() = entry;
+        std::push_heap(heap.begin(), heap.end(), compare);
+    }
+}
+
+/**
+ * @brief Offers items of a category.
+ *
+ * When ranking by date, the items must be in date order, as returned by
+ * Category::getItems. They are then visited from the most recent, stopping at the
+ * first item older than every kept expense once limit are kept.
+ *
+ * @param c The Category the items belong to.
+ * @param selection The items to offer.
+ */
+void Top::add(const Category& c, const std::vector<const Item*>& selection) {
+    if (by == AMOUNT) {
+        for (const Item* item : selection) {
+            offer(Entry{&c, item});
+        }
+        return;
+    }
+    for (auto it = selection.rbegin(); it != selection.rend(); ++it) {
+        if (heap.size() == limit && (limit == 0 || (*it)->getDate() < heap.front().item->getDate())) {
+            break;
+        }
+        offer(Entry{&c, *it});
+    }
+}
+
+/**
+ * @brief Offers the expenses kept by another Top to this one.
+ *
+ * @param other The other Top, whose categories must still exist.
+ */
+void Top::merge(const Top& other) {
+    for (const Entry& entry : other.heap) {
+        offer(entry);
+    }
+}
+
+/**
+ * @brief Returns the number of expenses kept.
+ *
+ * @return std::size_t The number of expenses, at most limit.
+ */
+std::size_t Top::size() const {
+    return heap.size();
+}
+
+/**
+ * @brief Returns the expenses kept, in rank order.
+ *
+ * @return std::vector<const Item*> The items, highest ranked first.
+ */
+std::vector<const Item*> Top::items() const {
+    std::vector<Entry> ranked = heap;
+    std::sort_heap(ranked.begin(), ranked.end(),
+                   [this](const Entry& a, const Entry& b) { return before(a, b); });
+    std::vector<const Item*> result;
+    result.reserve(ranked.size());
+    for (const Entry& entry : ranked) {
+        result.push_back(entry.item);
+    }
+    return result;
+}
+
+/**
+ * @brief Writes the expenses kept as a JSON array in rank order, with one object per
+ * expense holding its category, identifier and fields, e.g.
+ * [{"category":"Studies","item":"1","amount":999.99,"date":"2024-12-25",
+ * "description":"Laptop","tags":["uni"]}].
+ *
+ * @param out The Writer to write to.
+ */
+void Top::write(Writer& out) const {
+    std::vector<Entry> ranked = heap;
+    std::sort_heap(ranked.begin(), ranked.end(),
+                   [this](const Entry& a, const Entry& b) { return before(a, b); });
+    out.put('[');
+    for (auto it = ranked.begin(); it != ranked.end(); ++it) {
+        if (it != ranked.begin()) {
+            out.put(',');
+        }
+        const Item& item = *it->item;
+        out.write("{\"category\":\"", 13);
+        out.write(it->category->getIdent());
+        out.write("\",\"item\":\"", 10);
+        out.write(item.getIdent());
+        out.write("\",\"amount\":", 11);
+        item.getAmount().write(out);
+        out.write(",\"date\":\"", 9);
+        item.getDate().write(out);
+        out.write("\",\"description\":\"", 17);
+        out.write(item.getDescription());
+        out.write("\",\"tags\":[", 10);
+        const TagNames tags = item.getTags();
+        for (auto tag = tags.begin(); tag != tags.end(); ++tag) {
+            if (tag != tags.begin()) {
+                out.put(',');
+            }
+            out.put('"');
+            out.write(*tag);
+            out.put('"');
+        }
+        out.write("]}", 2);
+    }
+    out.put(']');
+}
@@ -0,0 +1,59 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// A Top holds the K largest or most recent expenses added
+// to it, in a bounded heap, so finding them never sorts
+// more than K items. Tops built for different categories
+// can be merged, and the expenses are written out in rank
+// order as JSON.
+// -----------------------------------------------------
+
+#ifndef TOP_H
+#define TOP_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "category.h"
+
+class Writer;
+
+class Top
+{
+public:
+    enum Order { AMOUNT, DATE };
+
+private:
+    struct Entry
+    {
+        const Category* category;
+        const Item* item;
+    };
+
+    Order by;
+    std::size_t limit;
+    // A heap whose front is the lowest ranked of the kept expenses.
+    std::vector<Entry> heap;
+
+    bool before(const Entry& a, const Entry& b) const;
+    void offer(const Entry& entry);
+
+public:
+    Top(Order by, std::size_t limit);
+
+    static Order parseOrder(const std::string& order);
+
+    void add(const Category& c, const std::vector<const Item*>& selection);
+    void merge(const Top& other);
+    std::size_t size() const;
+
+    std::vector<const Item*> items() const;
+    void write(Writer& out) const;
+};
+
+#endif // TOP_H
@@ -0,0 +1,178 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+
+#include "writer.h"
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @brief Constructs a Writer with an empty buffer.
+ */
+Writer::Writer() : used(0) {}
+
+/**
+ * @brief Destructor. Derived classes flush any buffered output themselves,
+ * as the sink is no longer available here.
+ */
+Writer::~Writer() {}
+
+/**
+ * @brief Writes a block of bytes.
+ *
+ * Small writes are collected in the buffer; blocks larger than the buffer are
+ * passed straight to the sink.
+ *
+ * @param data The bytes to write.
+ * @param n The number of bytes.
+ */
+void Writer::write(const char* data, std::size_t n) {
+    if (used + n > CAPACITY) {
+        flush();
+        if (n > CAPACITY) {
+            sink(data, n);
+            return;
+        }
+    }
+    std::memcpy(buffer + used, data, n);
+    used += n;
+}
+
+/**
+ * @brief Writes a string.
+ *
+ * @param s The string to write.
+ */
+void Writer::write(std::string_view s) {
+    write(s.data(), s.size());
+}
+
+/**
+ * @brief Writes a single character.
+ *
+ * @param c The character to write.
+ */
+void Writer::put(char c) {
+    if (used == CAPACITY) {
+        flush();
+    }
+    buffer[used++] = c;
+}
+
+/**
+ * @brief Passes everything buffered so far on to the sink.
+ */
+void Writer::flush() {
+    if (used > 0) {
+        sink(buffer, used);
+        used = 0;
+    }
+}
+
+/**
+ * @brief Constructs a StringWriter with an empty output string.
+ */
+StringWriter::StringWriter() {}
+
+/**
+ * @brief Destructor.
+ */
+StringWriter::~StringWriter() {}
+
+/**
+ * @brief Appends a block of output to the string.
+ *
+ * @param data The bytes to append.
+ * @param n The number of bytes.
+ */
+void StringWriter::sink(const char* data, std::size_t n) {
+    output.append(data, n);
+}
+
+/**
+ * @brief Returns everything written so far.
+ *
+ * @return std::string The output.
+ */
+std::string StringWriter::str() {
+    flush();
+    return output;
+}
+
+/**
+ * @brief Constructs a FileWriter that replaces the contents of a file.
+ *
+ * @param filename The path of the file to write.
+ * @throws std::runtime_error if the file cannot be opened.
+ */
+FileWriter::FileWriter(const std::string& filename)
+    : filename(filename), file(filename, std::ios::binary) {
+    if (!file.is_open()) {
+        throw std::runtime_error("File not found: " + filename);
+    }
+}
+
+/**
+ * @brief Destructor, writing out anything still buffered. Use close() to find out
+ * whether writing succeeded.
+ */
+FileWriter::~FileWriter() {
+    if (file.is_open()) {
+        try {
+            flush();
+        } catch (...) {
+        }
+    }
+}
+
+/**
+ * @brief Writes a block of output to the file.
+ *
+ * @param data The bytes to write.
+ * @param n The number of bytes.
+ */
+void FileWriter::sink(const char* data, std::size_t n) {
+    file.write(data, static_cast<std::streamsize>(n));
+}
+
+/**
+ * @brief Writes out anything still buffered and closes the file.
+ *
+ * @throws std::runtime_error if any of the output could not be written.
+ */
+void FileWriter::close() {
+    flush();
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + filename);
+    }
+}
+
+/**
+ * @brief Constructs a StreamWriter that writes to a stream.
+ *
+ * @param stream The stream to write to, which must outlive the StreamWriter.
+ */
+StreamWriter::StreamWriter(std::ostream& stream) : stream(stream) {}
+
+/**
+ * @brief Destructor, writing out anything still buffered.
+ */
+StreamWriter::~StreamWriter() {
+    flush();
+}
+
+/**
+ * @brief Writes a block of output to the stream.
+ *
+ * @param data The bytes to write.
+ * @param n The number of bytes.
+ */
+void StreamWriter::sink(const char* data, std::size_t n) {
+    stream.write(data, static_cast<std::streamsize>(n));
+}
@@ -0,0 +1,93 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// A Writer is the destination that ExpenseTracker,
+// Category, Item and Date serialize their JSON into. It
+// collects output in a fixed-size buffer and hands it on
+// in blocks, either to a string (StringWriter), a file
+// (FileWriter) or a stream such as std::cout
+// (StreamWriter), so serializing to disk never needs a
+// copy of the whole output in memory.
+// -----------------------------------------------------
+
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <cstddef>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+class Writer
+{
+private:
+    static const std::size_t CAPACITY = 8192;
+    char buffer[CAPACITY];
+    std::size_t used;
+
+protected:
+    virtual void sink(const char* data, std::size_t n) = 0;
+
+public:
+    Writer();
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+    virtual ~Writer();
+
+    void write(const char* data, std::size_t n);
+    void write(std::string_view s);
+    void put(char c);
+    void flush();
+};
+
+class StringWriter : public Writer
+{
+private:
+    std::string output;
+
+protected:
+    void sink(const char* data, std::size_t n) override;
+
+public:
+    StringWriter();
+    ~StringWriter() override;
+
+    std::string str();
+};
+
+class FileWriter : public Writer
+{
+private:
+    std::string filename;
+    std::ofstream file;
+
+protected:
+    void sink(const char* data, std::size_t n) override;
+
+public:
+    FileWriter(const std::string& filename);
+    ~FileWriter() override;
+
+    void close();
+};
+
+class StreamWriter : public Writer
+{
+private:
+    std::ostream& stream;
+
+protected:
+    void sink(const char* data, std::size_t n) override;
+
+public:
+    StreamWriter(std::ostream& stream);
+    ~StreamWriter() override;
+};
+
+#endif // WRITER_H
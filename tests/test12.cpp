@@ -0,0 +1,186 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests saving and loading binary
+// snapshots of the ExpenseTracker, and selecting the
+// binary format with the format program argument.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <fstream>
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+#include "../src/expensetracker.h"
+
+SCENARIO("A ExpenseTracker object can round-trip through a binary snapshot",
+         "[expensetracker]") {
+
+  const std::string jsonPath = "./tests/testdatabase.json";
+  const std::string binaryPath = "./tests/testdatabasealt.bin";
+
+  GIVEN("an ExpenseTracker loaded from a JSON database") {
+
+    ExpenseTracker etObj1{};
+    REQUIRE_NOTHROW(etObj1.load(jsonPath));
+    REQUIRE(etObj1.size() == 2);
+
+    WHEN("it is saved as a binary snapshot") {
+
+      REQUIRE_NOTHROW(etObj1.saveBinary(binaryPath));
+
+      THEN("the file is recognised as binary and the JSON file is not") {
+
+        REQUIRE(ExpenseTracker::isBinary(binaryPath));
+        REQUIRE_FALSE(ExpenseTracker::isBinary(jsonPath));
+
+      } // THEN
+
+      AND_WHEN("the snapshot is loaded into a new ExpenseTracker object") {
+
+        ExpenseTracker etObj2{};
+        REQUIRE_NOTHROW(etObj2.loadBinary(binaryPath));
+
+        THEN("both ExpenseTracker objects are equal") {
+
+          REQUIRE(etObj2 == etObj1);
+          REQUIRE(etObj2.str() == etObj1.str());
+          REQUIRE(etObj2.getCategory("Studies").getItem("2").getTags() ==
+                  etObj1.getCategory("Studies").getItem("2").getTags());
+
+        } // THEN
+
+      } // AND_WHEN
+
+      AND_WHEN("the snapshot's version is changed to an older one") {
+
+        std::fstream f{binaryPath, std::ios::in | std::ios::out | std::ios::binary};
+        f.seekp(4);
+        f.put(2);
+        f.close();
+
+        ExpenseTracker etObj2{};
+
+        THEN("a std::runtime_error exception is thrown") {
+
+          REQUIRE_THROWS_AS(etObj2.loadBinary(binaryPath), std::runtime_error);
+
+        } // THEN
+
+      } // AND_WHEN
+
+    } // WHEN
+
+    WHEN("an item dated on the latest valid date is saved as a binary snapshot") {
+
+      etObj1.getCategory("Studies").getItem("2").setDate(Date::latest());
+      REQUIRE_NOTHROW(etObj1.saveBinary(binaryPath));
+
+      AND_WHEN("the snapshot is loaded into a new ExpenseTracker object") {
+
+        ExpenseTracker etObj2{};
+        REQUIRE_NOTHROW(etObj2.loadBinary(binaryPath));
+
+        THEN("the date is unchanged") {
+
+          REQUIRE(etObj2.getCategory("Studies").getItem("2").getDate() ==
+                  Date::latest());
+          REQUIRE(etObj2 == etObj1);
+
+        } // THEN
+
+      } // AND_WHEN
+
+    } // WHEN
+
+    WHEN("a JSON file is loaded as a binary snapshot") {
+
+      ExpenseTracker etObj2{};
+
+      THEN("a std::runtime_error exception is thrown") {
+
+        REQUIRE_THROWS_AS(etObj2.loadBinary(jsonPath), std::runtime_error);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("The format program argument selects the database format", "[args]") {
+
+  GIVEN("a --format program argument and value") {
+
+    WHEN("the value is 'binary'") {
+
+      Argv argvObj({"test", "--format", "binary"});
+      auto **argv = argvObj.argv();
+      auto argc = argvObj.argc();
+
+      auto cxxopts = App::cxxoptsSetup();
+      auto args = cxxopts.parse(argc, argv);
+
+      THEN("the response is Format::BINARY") {
+
+        REQUIRE(App::parseFormatArgument(args, "database.json") ==
+                App::Format::BINARY);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the value is not an expected format ('invalid')") {
+
+      Argv argvObj({"test", "--format", "invalid"});
+      auto **argv = argvObj.argv();
+      auto argc = argvObj.argc();
+
+      auto cxxopts = App::cxxoptsSetup();
+      auto args = cxxopts.parse(argc, argv);
+
+      THEN("a std::invalid_argument exception is thrown") {
+
+        REQUIRE_THROWS_AS(App::parseFormatArgument(args, "database.json"),
+                          std::invalid_argument);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("no --format program argument") {
+
+    Argv argvObj({"test"});
+    auto **argv = argvObj.argv();
+    auto argc = argvObj.argc();
+
+    auto cxxopts = App::cxxoptsSetup();
+    auto args = cxxopts.parse(argc, argv);
+
+    THEN("the format follows the db filename extension") {
+
+      REQUIRE(App::parseFormatArgument(args, "database.bin") ==
+              App::Format::BINARY);
+      REQUIRE(App::parseFormatArgument(args, "database.json") ==
+              App::Format::JSON);
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
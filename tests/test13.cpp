@@ -0,0 +1,133 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file tests the journal program argument, which
+// appends changes to a journal instead of rewriting the
+// database, and the 'compact' value of the action
+// argument, which folds the journal back in.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+#include "../src/journal.h"
+
+SCENARIO("Changes can be journaled and compacted into the database", "[args]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+  const std::string journalPath = Journal::pathFor(filePath);
+
+  auto fileExists = [](const std::string &path) {
+    return std::ifstream(path).is_open();
+  };
+
+  auto readFileContents = [](const std::string &path) {
+    std::stringstream ss{std::stringstream::out};
+    ss << std::ifstream(path).rdbuf();
+    return ss.str();
+  };
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file and no journal") {
+
+    const std::string contents =
+        "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+        "\"description\":\"Laptop\",\"tags\":[\"uni\"]}}}";
+    std::remove(journalPath.c_str());
+    REQUIRE_NOTHROW(writeFileContents(filePath, contents));
+
+    WHEN("an item is created and a tag deleted with the journal argument") {
+
+      Argv argvObj1({"test", "--db", filePath.c_str(), "--action", "create",
+                     "--category", "Travel", "--item", "2", "--description",
+                     "Bus Pass", "--amount", "164", "--date", "2024-12-30",
+                     "--journal"});
+      REQUIRE_NOTHROW(App::run(argvObj1.argc(), argvObj1.argv()));
+
+      Argv argvObj2({"test", "--db", filePath.c_str(), "--action", "delete",
+                     "--category", "Studies", "--item", "1", "--tag", "uni",
+                     "--journal"});
+      REQUIRE_NOTHROW(App::run(argvObj2.argc(), argvObj2.argv()));
+
+      THEN("the database file is unchanged and a journal exists") {
+
+        REQUIRE(readFileContents(filePath) == contents);
+        REQUIRE(fileExists(journalPath));
+
+      } // THEN
+
+      THEN("loading the database replays the journal") {
+
+        ExpenseTracker etObj1{};
+        REQUIRE_NOTHROW(etObj1.load(filePath));
+        REQUIRE(etObj1.size() == 2);
+        REQUIRE(etObj1.getCategory("Travel").getItem("2").getAmount() == 164.0);
+        REQUIRE(etObj1.getCategory("Studies").getItem("1").numTags() == 0);
+
+      } // THEN
+
+      AND_WHEN("the compact action is run") {
+
+        Argv argvObj3({"test", "--db", filePath.c_str(), "--action", "compact"});
+        REQUIRE_NOTHROW(App::run(argvObj3.argc(), argvObj3.argv()));
+
+        THEN("the journal is removed and the database holds the changes") {
+
+          REQUIRE_FALSE(fileExists(journalPath));
+
+          ExpenseTracker etObj2{};
+          REQUIRE_NOTHROW(etObj2.load(filePath));
+          REQUIRE(etObj2.size() == 2);
+          REQUIRE(etObj2.getCategory("Travel").getItem("2").getDescription() ==
+                  "Bus Pass");
+          REQUIRE(etObj2.getCategory("Studies").getItem("1").numTags() == 0);
+
+        } // THEN
+
+      } // AND_WHEN
+
+    } // WHEN
+
+    WHEN("the database is replaced after the journal was written") {
+
+      Argv argvObj1({"test", "--db", filePath.c_str(), "--action", "create",
+                     "--category", "Travel", "--journal"});
+      REQUIRE_NOTHROW(App::run(argvObj1.argc(), argvObj1.argv()));
+      REQUIRE_NOTHROW(writeFileContents(filePath, "{}"));
+
+      THEN("the stale journal is not replayed") {
+
+        ExpenseTracker etObj1{};
+        REQUIRE_NOTHROW(etObj1.load(filePath));
+        REQUIRE(etObj1.size() == 0);
+
+      } // THEN
+
+    } // WHEN
+
+    std::remove(journalPath.c_str());
+
+  } // GIVEN
+
+} // SCENARIO
@@ -0,0 +1,188 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests opening JSON files lazily
+// into the ExpenseTracker, parsing each Category only
+// when it is used.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../src/expensetracker.h"
+
+SCENARIO("A ExpenseTracker object can open a JSON file lazily", "[expensetracker]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{ \"Studies\": { \"1\": { \"amount\": 999.99, \"date\": \"2024-12-25\", "
+        "\"description\": \"Laptop\", \"tags\": [ \"computer\", \"uni\" ] } }, "
+        "\"Travel\": { \"3\": { \"amount\": 164.0, \"date\": \"2024-12-30\", "
+        "\"description\": \"Bus {Pass}\", \"tags\": [ \"bus\", \"uni\"] } }, "
+        "\"Broken\": { \"4\": { \"amount\": \"oops\" } } }"));
+
+    WHEN("the file is opened") {
+
+      ExpenseTracker etObj1{};
+      REQUIRE_NOTHROW(etObj1.open(filePath));
+
+      THEN("every category is counted") {
+
+        REQUIRE(etObj1.size() == 3);
+
+      } // THEN
+
+      THEN("a category is parsed when it is retrieved") {
+
+        REQUIRE(etObj1.getCategory("Travel").size() == 1);
+        REQUIRE(etObj1.getCategory("Travel").getItem("3").getDescription() ==
+                "Bus {Pass}");
+        REQUIRE(etObj1.getCategory("Travel").getItem("3").numTags() == 2);
+        REQUIRE_THROWS_AS(etObj1.getCategory("Missing"), std::out_of_range);
+
+      } // THEN
+
+      THEN("an invalid category only fails when it is used") {
+
+        REQUIRE(etObj1.getCategory("Studies").getSum() == 999.99);
+        REQUIRE_THROWS_AS(etObj1.getCategory("Broken"), std::runtime_error);
+
+        AND_WHEN("the invalid category is deleted without being parsed") {
+
+          REQUIRE(etObj1.deleteCategory("Broken"));
+
+          THEN("it is no longer counted") {
+
+            REQUIRE(etObj1.size() == 2);
+            REQUIRE_THROWS_AS(etObj1.getCategory("Broken"), std::out_of_range);
+
+          } // THEN
+
+        } // AND_WHEN
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the file is opened and the invalid category deleted") {
+
+      ExpenseTracker etObj1{};
+      REQUIRE_NOTHROW(etObj1.open(filePath));
+      REQUIRE(etObj1.deleteCategory("Broken"));
+
+      AND_WHEN("it is saved and loaded eagerly") {
+
+        REQUIRE_NOTHROW(etObj1.save(filePath));
+
+        ExpenseTracker etObj2{};
+        REQUIRE_NOTHROW(etObj2.load(filePath));
+
+        THEN("both ExpenseTracker objects are equal") {
+
+          REQUIRE(etObj2.size() == 2);
+          REQUIRE(etObj1 == etObj2);
+          REQUIRE(etObj1.str() == etObj2.str());
+
+        } // THEN
+
+      } // AND_WHEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("Loading and opening a JSON file give the same result", "[expensetracker]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a database JSON file in which a category appears twice") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{ \"Travel\": { \"1\": { \"amount\": 1.0, \"date\": \"2024-12-01\", "
+        "\"description\": \"Bus\", \"tags\": [] } }, "
+        "\"Travel\": { \"2\": { \"amount\": 2.0, \"date\": \"2024-12-02\", "
+        "\"description\": \"Train\", \"tags\": [] } } }"));
+
+    WHEN("it is loaded and opened") {
+
+      ExpenseTracker etObj1{};
+      REQUIRE_NOTHROW(etObj1.load(filePath));
+      ExpenseTracker etObj2{};
+      REQUIRE_NOTHROW(etObj2.open(filePath));
+
+      THEN("only the last occurrence is read, either way") {
+
+        REQUIRE(etObj1.getCategory("Travel").size() == 1);
+        REQUIRE(etObj1.getCategory("Travel").getItem("2").getDescription() == "Train");
+        REQUIRE(etObj1 == etObj2);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("database JSON files with an item missing a field") {
+
+    const std::vector<std::string> items{
+        "{ \"date\": \"2024-12-01\", \"description\": \"Bus\", \"tags\": [] }",
+        "{ \"amount\": 1.0, \"date\": \"2024-12-01\", \"tags\": [] }",
+        "{ \"amount\": 1.0, \"description\": \"Bus\", \"tags\": [] }"};
+
+    THEN("loading each of them throws a std::runtime_error") {
+
+      for (const auto &item : items) {
+        REQUIRE_NOTHROW(writeFileContents(filePath, "{ \"Travel\": { \"1\": " + item + " } }"));
+        ExpenseTracker etObj1{};
+        REQUIRE_THROWS_AS(etObj1.load(filePath), std::runtime_error);
+      }
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a database JSON file followed by more content") {
+
+    REQUIRE_NOTHROW(writeFileContents(filePath, "{ \"Travel\": {} } {}"));
+
+    THEN("loading and opening it throw a std::runtime_error") {
+
+      ExpenseTracker etObj1{};
+      REQUIRE_THROWS_AS(etObj1.load(filePath), std::runtime_error);
+      REQUIRE_THROWS_AS(etObj1.open(filePath), std::runtime_error);
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
@@ -0,0 +1,260 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests tracking which Category
+// objects changed, and saving only those categories
+// again.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../src/expensetracker.h"
+
+#include "test.h"
+
+SCENARIO("Changes to items and categories are tracked", "[category]") {
+
+  GIVEN("a clean Category containing an Item") {
+
+    Category cObj1{categoryIdent};
+    cObj1.newItem(ident, description, amount, date);
+    cObj1.markClean();
+    REQUIRE_FALSE(cObj1.isDirty());
+
+    WHEN("a tag is added to the item through the category") {
+
+      cObj1.getItem(ident).addTag("tag");
+
+      THEN("the category is dirty") {
+
+        REQUIRE(cObj1.isDirty());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a copy of the item is changed") {
+
+      Item iObj = cObj1.getItem(ident);
+      iObj.setAmount(Money(amount2));
+
+      THEN("the category is still clean") {
+
+        REQUIRE_FALSE(cObj1.isDirty());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the category is copied and an item of the copy is changed") {
+
+      Category cObj2 = cObj1;
+      cObj2.markClean();
+      cObj2.getItem(ident).setDescription(description2);
+
+      THEN("only the copy is dirty") {
+
+        REQUIRE(cObj2.isDirty());
+        REQUIRE_FALSE(cObj1.isDirty());
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("Only changed categories are serialized again when saving",
+         "[expensetracker]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto readFileContents = [](const std::string &path) {
+    std::stringstream ss{std::stringstream::out};
+    ss << std::ifstream(path).rdbuf();
+    return ss.str();
+  };
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a database JSON file that is not in the format save writes") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{ \"Studies\": { \"1\": { \"amount\": 999.99, \"date\": \"2024-12-25\", "
+        "\"description\": \"Laptop\", \"tags\": [ \"uni\" ] } }, "
+        "\"Travel\": { \"3\": { \"amount\": 164.0, \"date\": \"2024-12-30\", "
+        "\"description\": \"Bus Pass\", \"tags\": [ \"bus\" ] } } }"));
+
+    WHEN("the file is opened") {
+
+      ExpenseTracker etObj1{};
+      REQUIRE_NOTHROW(etObj1.open(filePath));
+
+      THEN("the ExpenseTracker is clean, even after reading a category") {
+
+        REQUIRE(etObj1.getCategory("Travel").getSum() == 164.0);
+        REQUIRE_FALSE(etObj1.isDirty());
+
+      } // THEN
+
+      AND_WHEN("a tag is added to an item in one category and it is saved") {
+
+        etObj1.getCategory("Travel").getItem("3").addTag("uni");
+        REQUIRE(etObj1.isDirty());
+        REQUIRE_NOTHROW(etObj1.save(filePath));
+
+        THEN("the changed category is serialized and the other copied as it was") {
+
+          REQUIRE(readFileContents(filePath) ==
+                  "{\"Studies\":{ \"1\": { \"amount\": 999.99, \"date\": "
+                  "\"2024-12-25\", \"description\": \"Laptop\", \"tags\": [ "
+                  "\"uni\" ] } },\"Travel\":{\"3\":{\"amount\":164.0,\"date\":"
+                  "\"2024-12-30\",\"description\":\"Bus Pass\",\"tags\":["
+                  "\"bus\",\"uni\"]}}}");
+
+        } // THEN
+
+      } // AND_WHEN
+
+    } // WHEN
+
+  } // GIVEN
+
+} // SCENARIO
+
+SCENARIO("Loading into a lazily opened database keeps the merged items when saving",
+         "[expensetracker]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+  const std::string otherPath = "./tests/testdatabasemerge.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("two database JSON files that both have the same category") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{ \"Studies\": { \"1\": { \"amount\": 999.99, \"date\": \"2024-12-25\", "
+        "\"description\": \"Laptop\", \"tags\": [ \"uni\" ] } }, "
+        "\"Travel\": { \"3\": { \"amount\": 164.0, \"date\": \"2024-12-30\", "
+        "\"description\": \"Bus Pass\", \"tags\": [ \"bus\" ] } } }"));
+    REQUIRE_NOTHROW(writeFileContents(
+        otherPath,
+        "{ \"Travel\": { \"4\": { \"amount\": 2.5, \"date\": \"2024-12-31\", "
+        "\"description\": \"Ticket\", \"tags\": [] } } }"));
+
+    WHEN("the first is opened, the category read, the second loaded and it is saved") {
+
+      ExpenseTracker etObj1{};
+      REQUIRE_NOTHROW(etObj1.open(filePath));
+      REQUIRE(etObj1.getCategory("Travel").size() == 1);
+      REQUIRE_NOTHROW(etObj1.load(otherPath));
+      REQUIRE(etObj1.getCategory("Travel").size() == 2);
+      REQUIRE_NOTHROW(etObj1.save(filePath));
+
+      THEN("the saved file holds the items of both") {
+
+        ExpenseTracker etObj2{};
+        REQUIRE_NOTHROW(etObj2.load(filePath));
+        REQUIRE(etObj2.getCategory("Travel").size() == 2);
+        REQUIRE(etObj2 == etObj1);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a category is changed before the second is loaded") {
+
+      ExpenseTracker etObj1{};
+      REQUIRE_NOTHROW(etObj1.open(filePath));
+      etObj1.getCategory("Studies").getItem("1").addTag("laptop");
+      REQUIRE_NOTHROW(etObj1.load(otherPath));
+
+      THEN("the change is still unsaved") {
+
+        REQUIRE(etObj1.isDirty());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a category is added before the first is opened") {
+
+      ExpenseTracker etObj1{};
+      etObj1.newCategory("New");
+      REQUIRE_NOTHROW(etObj1.open(filePath));
+
+      THEN("the change is still unsaved") {
+
+        REQUIRE(etObj1.isDirty());
+        REQUIRE(etObj1.size() == 3);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a category is added before a binary snapshot is loaded") {
+
+      const std::string binaryPath = "./tests/testdatabasealt.bin";
+      ExpenseTracker etObj1{};
+      REQUIRE_NOTHROW(etObj1.load(otherPath));
+      REQUIRE_NOTHROW(etObj1.saveBinary(binaryPath));
+      ExpenseTracker etObj2{};
+      etObj2.newCategory("New");
+      REQUIRE_NOTHROW(etObj2.loadBinary(binaryPath));
+      std::remove(binaryPath.c_str());
+
+      THEN("the change is still unsaved") {
+
+        REQUIRE(etObj2.isDirty());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a binary snapshot is loaded into a new ExpenseTracker") {
+
+      const std::string binaryPath = "./tests/testdatabasealt.bin";
+      ExpenseTracker etObj1{};
+      REQUIRE_NOTHROW(etObj1.load(otherPath));
+      REQUIRE_NOTHROW(etObj1.saveBinary(binaryPath));
+      ExpenseTracker etObj2{};
+      REQUIRE_NOTHROW(etObj2.loadBinary(binaryPath));
+      std::remove(binaryPath.c_str());
+
+      THEN("it is clean") {
+
+        REQUIRE_FALSE(etObj2.isDirty());
+
+      } // THEN
+
+    } // WHEN
+
+    std::remove(otherPath.c_str());
+
+  } // GIVEN
+
+} // SCENARIO
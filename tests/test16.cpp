@@ -0,0 +1,236 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for Money amounts: parsing
+// and writing them, adding them up exactly, printing
+// sums, and saving existing databases without changing
+// their text.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+#include "../src/expensetracker.h"
+#include "../src/money.h"
+
+#include "test.h"
+
+// Redirect std::cout to a buffer
+// by Björn Pollex
+// via https://stackoverflow.com/a/5419388
+// licensed under CC BY-SA 3.0.
+class CoutRedirect {
+private:
+  std::streambuf *old;
+
+public:
+  CoutRedirect(std::streambuf *new_buffer)
+      : old(std::cout.rdbuf(new_buffer)) { /* do nothing */
+  }
+
+  ~CoutRedirect() { std::cout.rdbuf(old); }
+};
+
+// How an amount was written when Item held it as a double.
+static std::string streamAmount(double amount) {
+  std::ostringstream os;
+  if (std::floor(amount) == amount) {
+    os << std::fixed << std::setprecision(1) << amount;
+  } else {
+    os << amount;
+  }
+  return os.str();
+}
+
+SCENARIO("Amounts are parsed and written exactly", "[money]") {
+
+  GIVEN("amounts as text") {
+
+    THEN("they are parsed into hundredths") {
+
+      REQUIRE(Money::parse("39.99").getUnits() == 3999);
+      REQUIRE(Money::parse("164.0").getUnits() == 16400);
+      REQUIRE(Money::parse("164").getUnits() == 16400);
+      REQUIRE(Money::parse("-0.5").getUnits() == -50);
+      REQUIRE(Money::parse("1.23457e+06").getUnits() == 123457000);
+      REQUIRE(Money::parse("2.5500").getUnits() == 255);
+      REQUIRE(Money::parse("0e99").getUnits() == 0);
+
+    } // THEN
+
+    THEN("text that is not a number is rejected") {
+
+      REQUIRE_THROWS_AS(Money::parse(""), std::invalid_argument);
+      REQUIRE_THROWS_AS(Money::parse("abc"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Money::parse("1.5x"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Money::parse("1e"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Money::parse("1e30"), std::out_of_range);
+
+    } // THEN
+
+    THEN("amounts with digits beyond the hundredths are rejected") {
+
+      REQUIRE_THROWS_AS(Money::parse("0.285"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Money::parse("2.5501"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Money::parse("1e-3"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Money::parse("0.0000001"), std::invalid_argument);
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("amounts in hundredths") {
+
+    THEN("they are written as they were when held as doubles") {
+
+      REQUIRE(Money::fromUnits(16400).str() == "164.0");
+      REQUIRE(Money::fromUnits(3999).str() == "39.99");
+      REQUIRE(Money::fromUnits(50).str() == "0.5");
+      REQUIRE(Money::fromUnits(-5).str() == "-0.05");
+
+      unsigned int differences = 0;
+      for (int units = -200000; units < 1000000; units += 7) {
+        if (Money::fromUnits(units).str() != streamAmount(units / 100.0)) {
+          differences++;
+        }
+      }
+      REQUIRE(differences == 0);
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("many small amounts") {
+
+    THEN("their sum is exact") {
+
+      Category cObj1{categoryIdent};
+      double doubleSum = 0.0;
+      for (int i = 0; i < 1000; i++) {
+        cObj1.newItem(std::to_string(i), description, 0.1, date);
+        doubleSum += 0.1;
+      }
+      REQUIRE(cObj1.getSum().getUnits() == 10000);
+      REQUIRE(doubleSum != 100.0);
+
+    } // THEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("Saving an existing database does not change its text", "[money]") {
+
+  const std::string filePath = "./tests/testdatabasemoney.json";
+  const std::string json =
+      "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+      "\"description\":\"Laptop\",\"tags\":[\"uni\"]},\"2\":{\"amount\":12345.7,"
+      "\"date\":\"2024-12-25\",\"description\":\"Car\",\"tags\":[]}},"
+      "\"Travel\":{\"3\":{\"amount\":164.0,\"date\":\"2024-12-30\","
+      "\"description\":\"Bus Pass\",\"tags\":[\"bus\"]},\"4\":{\"amount\":-0.5,"
+      "\"date\":\"2024-12-31\",\"description\":\"Refund\",\"tags\":[]},"
+      "\"5\":{\"amount\":1234570.0,\"date\":\"2024-12-31\",\"description\":"
+      "\"Yacht\",\"tags\":[]}}}";
+
+  GIVEN("a database written when amounts were doubles") {
+
+    {
+      std::ofstream f{filePath};
+      f << json;
+    }
+
+    WHEN("it is loaded and saved again") {
+
+      ExpenseTracker etObj1{};
+      etObj1.load(filePath);
+      etObj1.getCategory("Studies").getItem("1").setDescription("Laptop");
+      etObj1.getCategory("Travel").getItem("3").setDescription("Bus Pass");
+      etObj1.save(filePath);
+
+      THEN("the file is byte-identical") {
+
+        REQUIRE(etObj1.str() == json);
+
+        std::ifstream f{filePath};
+        std::stringstream buffer;
+        buffer << f.rdbuf();
+        REQUIRE(buffer.str() == json);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("The sum action prints the exact hundredths", "[money]") {
+
+  const std::string filePath = "./tests/testdatabasemoney.json";
+
+  GIVEN("a database whose total has more digits than a double holds") {
+
+    {
+      std::ofstream f{filePath};
+      f << "{\"Studies\":{\"1\":{\"amount\":12345678901234.56,\"date\":"
+           "\"2024-12-25\",\"description\":\"Campus\",\"tags\":[]},\"2\":{"
+           "\"amount\":0.01,\"date\":\"2024-12-26\",\"description\":\"Pen\","
+           "\"tags\":[]}},\"Travel\":{\"3\":{\"amount\":164.0,\"date\":"
+           "\"2024-12-30\",\"description\":\"Bus Pass\",\"tags\":[]}}}";
+    }
+
+    WHEN("the action is sum") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "sum"});
+
+      const std::streamsize precision = std::cout.precision();
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("the total is printed exactly and std::cout is left as it was") {
+
+        REQUIRE(buffer.str() == "12345678901398.57\n");
+        REQUIRE(std::cout.precision() == precision);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is sum for a category with a whole total") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "sum",
+                    "--category", "Travel"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("it is printed without decimal places") {
+
+        REQUIRE(buffer.str() == "164\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,109 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests keeping the running totals
+// of Category and ExpenseTracker objects up to date as
+// items are added, changed, and deleted.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <string>
+
+#include "../src/expensetracker.h"
+
+#include "test.h"
+
+SCENARIO("Category totals follow changes to their items", "[category]") {
+
+  GIVEN("a Category containing two Items") {
+
+    Category cObj1{categoryIdent};
+    cObj1.newItem(ident, description, amount, date);
+    cObj1.newItem(ident2, description2, amount2, date2);
+
+    REQUIRE(cObj1.getSum() == amount + amount2);
+    REQUIRE(cObj1.getSum() == cObj1.recomputeSum());
+
+    WHEN("an item's amount is changed") {
+
+      cObj1.getItem(ident).setAmount(Money(10.25));
+
+      THEN("the total follows") {
+
+        REQUIRE(cObj1.getSum() == 10.25 + amount2);
+        REQUIRE(cObj1.getSum() == cObj1.recomputeSum());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("an item is replaced, merged, added, and deleted") {
+
+      cObj1.newItem(ident, description, 1.0, date);
+      cObj1.addItem(Item(ident2, description2, 2.0, date2));
+      cObj1.addItem(Item("3", description, 3.0, date));
+      cObj1.deleteItem(ident);
+
+      THEN("the total follows") {
+
+        REQUIRE(cObj1.getSum() == 5.0);
+        REQUIRE(cObj1.getSum() == cObj1.recomputeSum());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the category is copied and an item of the copy is changed") {
+
+      Category cObj2 = cObj1;
+      cObj2.getItem(ident).setAmount(Money(0.0));
+
+      THEN("only the total of the copy changes") {
+
+        REQUIRE(cObj2.getSum() == amount2);
+        REQUIRE(cObj1.getSum() == amount + amount2);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("ExpenseTracker totals follow changes to their categories",
+         "[expensetracker]") {
+
+  GIVEN("an ExpenseTracker with two categories") {
+
+    ExpenseTracker etObj1{};
+    etObj1.newCategory("A").newItem(ident, description, amount, date);
+    etObj1.newCategory("B").newItem(ident2, description2, amount2, date2);
+
+    WHEN("an item changes and a category is deleted") {
+
+      etObj1.getCategory("B").getItem(ident2).setAmount(Money(7.77));
+      REQUIRE(etObj1.getSum() == amount + 7.77);
+      etObj1.deleteCategory("A");
+
+      THEN("the total follows") {
+
+        REQUIRE(etObj1.getSum() == 7.77);
+        REQUIRE(etObj1.getSum() == etObj1.recomputeSum());
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,164 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for summing and printing the
+// expenses dated between two dates, including the from
+// and to program arguments.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+
+// Redirect std::cout to a buffer
+// by Björn Pollex
+// via https://stackoverflow.com/a/5419388
+// licensed under CC BY-SA 3.0.
+class CoutRedirect {
+private:
+  std::streambuf *old;
+
+public:
+  CoutRedirect(std::streambuf *new_buffer)
+      : old(std::cout.rdbuf(new_buffer)) { /* do nothing */
+  }
+
+  ~CoutRedirect() { std::cout.rdbuf(old); }
+};
+
+SCENARIO("Expenses can be summed between two dates", "[category]") {
+
+  GIVEN("a Category with items on different dates") {
+
+    Category cObj1{"Food"};
+    cObj1.newItem("1", "Lunch", 5.50, Date("2024-10-31"));
+    cObj1.newItem("2", "Dinner", 20.00, Date("2024-11-01"));
+    cObj1.newItem("3", "Coffee", 2.75, Date("2024-11-15"));
+    cObj1.newItem("4", "Groceries", 41.20, Date("2024-11-30"));
+    cObj1.newItem("5", "Cake", 3.10, Date("2024-12-01"));
+
+    THEN("the range includes both of its ends") {
+
+      REQUIRE(cObj1.getSum(Date("2024-11-01"), Date("2024-11-30")) == 63.95);
+      REQUIRE(cObj1.getSum(Date("2024-11-15"), Date("2024-11-15")) == 2.75);
+      REQUIRE(cObj1.getSum(Date("2024-11-02"), Date("2024-11-14")) == 0.0);
+      REQUIRE(cObj1.getSum(Date("2024-12-01"), Date("2024-11-01")) == 0.0);
+      REQUIRE(cObj1.getItems(Date("2024-11-01"), Date("2024-11-30")).size() == 3);
+
+    } // THEN
+
+    WHEN("items are changed, added, and deleted after a query") {
+
+      REQUIRE(cObj1.getSum(Date("2024-11-01"), Date("2024-11-30")) == 63.95);
+      cObj1.getItem("3").setAmount(Money(3.00));
+      cObj1.getItem("5").setDate(Date("2024-11-20"));
+      cObj1.newItem("6", "Tea", 1.00, Date("2024-11-10"));
+      cObj1.deleteItem("2");
+
+      THEN("the next query sees the changes") {
+
+        REQUIRE(cObj1.getSum(Date("2024-11-01"), Date("2024-11-30")) == 48.30);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("The from and to program arguments limit the sum and json actions",
+         "[args]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+        "\"description\":\"Laptop\",\"tags\":[\"uni\"]},\"2\":{\"amount\":"
+        "39.99,\"date\":\"2024-11-20\",\"description\":\"C++ Book\",\"tags\":"
+        "[]}},\"Travel\":{\"3\":{\"amount\":164.0,\"date\":\"2024-12-30\","
+        "\"description\":\"Bus Pass\",\"tags\":[\"bus\"]}}}"));
+
+    WHEN("the action is sum with a from argument") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "sum",
+                    "--from", "2024-12-01"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("only expenses on or after that date are summed") {
+
+        REQUIRE(buffer.str() == "1163.99\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is json with a to argument") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "json",
+                    "--to", "2024-12-25"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("only expenses on or before that date are printed") {
+
+        REQUIRE(buffer.str() ==
+                "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+                "\"description\":\"Laptop\",\"tags\":[\"uni\"]},\"2\":{\"amount\":"
+                "39.99,\"date\":\"2024-11-20\",\"description\":\"C++ Book\","
+                "\"tags\":[]}}}\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is sum for a category with both arguments") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "sum",
+                    "--category", "Studies", "--from", "2024-11-01", "--to",
+                    "2024-11-30"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("only the category's expenses in the range are summed") {
+
+        REQUIRE(buffer.str() == "39.99\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,190 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for finding and summing the
+// expenses carrying a tag, including the tag program
+// argument with the sum and json actions.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+
+#include "test.h"
+
+// Redirect std::cout to a buffer
+// by Björn Pollex
+// via https://stackoverflow.com/a/5419388
+// licensed under CC BY-SA 3.0.
+class CoutRedirect {
+private:
+  std::streambuf *old;
+
+public:
+  CoutRedirect(std::streambuf *new_buffer)
+      : old(std::cout.rdbuf(new_buffer)) { /* do nothing */
+  }
+
+  ~CoutRedirect() { std::cout.rdbuf(old); }
+};
+
+SCENARIO("The expenses carrying a tag can be found and summed", "[category]") {
+
+  GIVEN("a Category with tagged items") {
+
+    Category cObj1{categoryIdent};
+    cObj1.newItem(ident, description, amount, date).addTag("uni");
+    cObj1.newItem(ident2, description2, amount2, date2).addTag("uni");
+    cObj1.getItem(ident2).addTag("food");
+
+    THEN("each tag finds its items") {
+
+      REQUIRE(cObj1.getSumForTag("uni") == amount + amount2);
+      REQUIRE(cObj1.getSumForTag("food") == amount2);
+      REQUIRE(cObj1.getSumForTag("none") == 0.0);
+      REQUIRE(cObj1.getItemsWithTag("uni").size() == 2);
+
+    } // THEN
+
+    WHEN("tags are deleted, items replaced and deleted, and items merged in") {
+
+      cObj1.getItem(ident).deleteTag("uni");
+      cObj1.newItem(ident2, description2, amount2, date2);
+      Item iObj{"3", description, 1.25, date};
+      iObj.addTag("food");
+      cObj1.addItem(iObj);
+      cObj1.addItem(iObj);
+      cObj1.getItem(ident).addTag("food");
+      cObj1.deleteItem(ident);
+
+      THEN("the tags find only the items that still carry them") {
+
+        REQUIRE(cObj1.getItemsWithTag("uni").empty());
+        REQUIRE(cObj1.getSumForTag("food") == 1.25);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the category is copied") {
+
+      Category cObj2 = cObj1;
+      cObj2.getItem(ident).deleteTag("uni");
+
+      THEN("each copy finds its own items") {
+
+        REQUIRE(cObj2.getSumForTag("uni") == amount2);
+        REQUIRE(cObj1.getSumForTag("uni") == amount + amount2);
+        REQUIRE(cObj2.getItemsWithTag("uni")[0] == &cObj2.getItem(ident2));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("The expenses carrying a tag can be summed between two dates",
+         "[category]") {
+
+  GIVEN("a Category with more distinct tags than the tag column has bits") {
+
+    Category cObj1{categoryIdent};
+    for (int i = 0; i < 100; i++) {
+      Item &iObj = cObj1.newItem(std::to_string(i), description, 1.0 + i,
+                                 Date(2024, 1 + i % 12, 1));
+      iObj.addTag("tag" + std::to_string(i));
+      iObj.addTag(i % 2 == 0 ? "even" : "odd");
+    }
+
+    THEN("every tag is found, whether or not it has a bit") {
+
+      REQUIRE(cObj1.getSum(Date::earliest(), Date::latest(), "tag3") == 4.0);
+      REQUIRE(cObj1.getSum(Date::earliest(), Date::latest(), "tag99") == 100.0);
+      REQUIRE(cObj1.getItems(Date("2024-04-01"), Date("2024-04-01"), "tag99").size() == 1);
+      REQUIRE(cObj1.getSum(Date("2024-01-01"), Date("2024-01-31"), "even") ==
+              cObj1.getSum(Date("2024-01-01"), Date("2024-01-31")));
+      REQUIRE(cObj1.getItems(Date("2024-01-01"), Date("2024-01-31"), "odd").empty());
+      REQUIRE(cObj1.getSum(Date::earliest(), Date::latest(), "none") == 0.0);
+
+    } // THEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("The tag program argument limits the sum and json actions", "[args]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+        "\"description\":\"Laptop\",\"tags\":[\"uni\"]},\"2\":{\"amount\":"
+        "39.99,\"date\":\"2024-11-20\",\"description\":\"C++ Book\",\"tags\":"
+        "[]}},\"Travel\":{\"3\":{\"amount\":164.0,\"date\":\"2024-12-30\","
+        "\"description\":\"Bus Pass\",\"tags\":[\"bus\",\"uni\"]}}}"));
+
+    WHEN("the action is sum with a tag argument") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "sum",
+                    "--tag", "uni"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("only expenses carrying the tag are summed") {
+
+        REQUIRE(buffer.str() == "1163.99\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is json with tag and to arguments") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "json",
+                    "--tag", "uni", "--to", "2024-12-29"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("only expenses carrying the tag in the range are printed") {
+
+        REQUIRE(buffer.str() ==
+                "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+                "\"description\":\"Laptop\",\"tags\":[\"uni\"]}}}\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
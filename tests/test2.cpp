@@ -275,4 +275,49 @@ SCENARIO("A custom date can be set from a date string", "[date]") {
 
   } // GIVEN
 
-} // SCENARIO
\ No newline at end of file
+} // SCENARIO
+
+SCENARIO("Dates keep their components and order across months and years",
+         "[date]") {
+
+  GIVEN("dates around a leap day and a year boundary") {
+
+    const Date dObj1 = Date("2023-12-31");
+    const Date dObj2 = Date("2024-01-01");
+    const Date dObj3 = Date("2024-02-29");
+    const Date dObj4 = Date("2024-03-01");
+
+    THEN("each date returns its own components and string") {
+
+      REQUIRE(dObj3.getYear() == 2024);
+      REQUIRE(dObj3.getMonth() == 2);
+      REQUIRE(dObj3.getDay() == 29);
+      REQUIRE(dObj1.str() == "2023-12-31");
+      REQUIRE(dObj4.str() == "2024-03-01");
+
+    } // THEN
+
+    THEN("the dates are ordered") {
+
+      REQUIRE(dObj1 < dObj2);
+      REQUIRE(dObj2 < dObj3);
+      REQUIRE(dObj3 < dObj4);
+      REQUIRE_FALSE(dObj4 < dObj1);
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("date strings with signs, spaces or days that do not exist") {
+
+    THEN("An exception is thrown") {
+
+      REQUIRE_THROWS_AS(Date("2024-+1-05"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Date("2023-02-29"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Date(" 024-01-05"), std::invalid_argument);
+
+    } // THEN
+
+  } // GIVEN
+
+} // SCENARIO
@@ -0,0 +1,172 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for the count, sum, minimum
+// and maximum of expenses, including the stats action.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+
+#include "test.h"
+
+// Redirect std::cout to a buffer
+// by Björn Pollex
+// via https://stackoverflow.com/a/5419388
+// licensed under CC BY-SA 3.0.
+class CoutRedirect {
+private:
+  std::streambuf *old;
+
+public:
+  CoutRedirect(std::streambuf *new_buffer)
+      : old(std::cout.rdbuf(new_buffer)) { /* do nothing */
+  }
+
+  ~CoutRedirect() { std::cout.rdbuf(old); }
+};
+
+SCENARIO("The aggregate kernels agree with each other", "[aggregate]") {
+
+  GIVEN("amounts and tag bits whose count is not a multiple of four") {
+
+    std::vector<std::int64_t> amounts;
+    std::vector<std::uint64_t> tags;
+    for (int i = 0; i < 1003; i++) {
+      amounts.push_back((i * 7919) % 20011 - 10000);
+      tags.push_back(std::uint64_t(1) << (i % 5));
+    }
+
+    THEN("every kernel gives the same result, with and without a tag mask") {
+
+      for (std::uint64_t mask : {std::uint64_t(0), std::uint64_t(1), std::uint64_t(6),
+                                 std::uint64_t(1) << 40}) {
+        const Aggregate scalar = aggregateScalar(amounts.data(), tags.data(),
+                                                 amounts.size(), mask);
+        const Aggregate dispatched = aggregate(amounts.data(), tags.data(),
+                                               amounts.size(), mask);
+        REQUIRE(dispatched.count == scalar.count);
+        REQUIRE(dispatched.sum == scalar.sum);
+        REQUIRE(dispatched.min == scalar.min);
+        REQUIRE(dispatched.max == scalar.max);
+        if (hasAvx2()) {
+          const Aggregate avx2 = aggregateAvx2(amounts.data(), tags.data(),
+                                               amounts.size(), mask);
+          REQUIRE(avx2.count == scalar.count);
+          REQUIRE(avx2.sum == scalar.sum);
+          REQUIRE(avx2.min == scalar.min);
+          REQUIRE(avx2.max == scalar.max);
+        }
+      }
+      REQUIRE(aggregateScalar(amounts.data(), tags.data(), amounts.size(), 0).count == 1003);
+      REQUIRE(aggregateScalar(amounts.data(), tags.data(), amounts.size(), 6).count == 402);
+      REQUIRE(aggregateScalar(amounts.data(), tags.data(), amounts.size(),
+                              std::uint64_t(1) << 40).count == 0);
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a Category with tagged items on different dates") {
+
+    Category cObj1{categoryIdent};
+    cObj1.newItem(ident, description, amount, Date("2024-01-10")).addTag("uni");
+    cObj1.newItem(ident2, description2, amount2, Date("2024-02-10")).addTag("uni");
+    cObj1.newItem("3", description, -5.5, Date("2024-03-10")).addTag("refund");
+
+    THEN("the statistics match the items in the range carrying the tag") {
+
+      const Aggregate all = cObj1.getStats(Date::earliest(), Date::latest());
+      REQUIRE(all.count == 3);
+      REQUIRE(Money::fromUnits(all.sum) == cObj1.getSum());
+      REQUIRE(all.min == -550);
+
+      const Aggregate uni = cObj1.getStats(Date("2024-02-01"), Date::latest(), "uni");
+      REQUIRE(uni.count == 1);
+      REQUIRE(Money::fromUnits(uni.min) == amount2);
+      REQUIRE(Money::fromUnits(uni.max) == amount2);
+
+      REQUIRE(cObj1.getStats(Date::earliest(), Date::latest(), "none").count == 0);
+
+    } // THEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("The stats action prints the statistics of expenses", "[args]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+        "\"description\":\"Laptop\",\"tags\":[\"uni\"]},\"2\":{\"amount\":"
+        "39.99,\"date\":\"2024-11-20\",\"description\":\"C++ Book\",\"tags\":"
+        "[]}},\"Travel\":{\"3\":{\"amount\":164.0,\"date\":\"2024-12-30\","
+        "\"description\":\"Bus Pass\",\"tags\":[\"bus\",\"uni\"]}}}"));
+
+    WHEN("the action is stats") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "stats"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("the statistics of every expense are printed") {
+
+        REQUIRE(buffer.str() == "count: 3\nsum: 1203.98\nmin: 39.99\n"
+                                "max: 999.99\nmean: 401.33\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is stats with category, tag and from arguments") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "stats",
+                    "--category", "Studies", "--tag", "uni", "--from",
+                    "2024-12-26"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("only the count and sum of no expenses are printed") {
+
+        REQUIRE(buffer.str() == "count: 0\nsum: 0\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,209 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for working on categories in
+// parallel, including the threads program argument.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+#include "../src/threadpool.h"
+
+// Redirect std::cout to a buffer
+// by Björn Pollex
+// via https://stackoverflow.com/a/5419388
+// licensed under CC BY-SA 3.0.
+class CoutRedirect {
+private:
+  std::streambuf *old;
+
+public:
+  CoutRedirect(std::streambuf *new_buffer)
+      : old(std::cout.rdbuf(new_buffer)) { /* do nothing */
+  }
+
+  ~CoutRedirect() { std::cout.rdbuf(old); }
+};
+
+SCENARIO("A ThreadPool runs every task once", "[threadpool]") {
+
+  GIVEN("a ThreadPool with four threads") {
+
+    ThreadPool pool{4};
+
+    THEN("each batch runs each task exactly once") {
+
+      REQUIRE(pool.size() == 4);
+      for (int batch = 0; batch < 20; batch++) {
+        std::vector<std::atomic<int>> runs(100);
+        pool.run(runs.size(), [&runs](std::size_t i) { runs[i]++; });
+        for (const auto &count : runs) {
+          REQUIRE(count == 1);
+        }
+      }
+
+    } // THEN
+
+    THEN("the exception of the lowest numbered failing task is rethrown") {
+
+      std::atomic<int> runs{0};
+      try {
+        pool.run(50, [&runs](std::size_t i) {
+          runs++;
+          if (i == 7 || i == 30) {
+            throw std::runtime_error(std::to_string(i));
+          }
+        });
+        FAIL("no exception was thrown");
+      } catch (const std::runtime_error &e) {
+        REQUIRE(std::string(e.what()) == "7");
+      }
+      REQUIRE(runs == 50);
+
+    } // THEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("Totals across categories do not depend on the number of threads",
+         "[expensetracker]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a database with many categories") {
+
+    ExpenseTracker etObj1{};
+    for (int c = 0; c < 40; c++) {
+      Category &cObj = etObj1.newCategory("Category" + std::to_string(c));
+      for (int i = 0; i < 50; i++) {
+        Item &iObj = cObj.newItem(std::to_string(i), "Item", 0.01 * (c * 50 + i),
+                                  Date(2024, 1 + i % 12, 1 + c % 28));
+        iObj.addTag(i % 3 == 0 ? "uni" : "home");
+      }
+    }
+    REQUIRE_NOTHROW(etObj1.save(filePath));
+
+    WHEN("it is opened lazily by a serial and a parallel ExpenseTracker") {
+
+      ExpenseTracker serial{};
+      REQUIRE_NOTHROW(serial.open(filePath));
+      ExpenseTracker parallel{};
+      parallel.setThreads(4);
+      REQUIRE_NOTHROW(parallel.open(filePath));
+
+      THEN("both give identical results") {
+
+        REQUIRE(parallel.getThreads() == 4);
+        const Date from("2024-03-01");
+        const Date to("2024-08-31");
+        REQUIRE(parallel.getSum(from, to) == serial.getSum(from, to));
+        REQUIRE(parallel.getSum(from, to, "uni") == serial.getSum(from, to, "uni"));
+        REQUIRE(parallel.getSumForTag("home") == serial.getSumForTag("home"));
+        REQUIRE(parallel.getStats(from, to, "uni").count == serial.getStats(from, to, "uni").count);
+        REQUIRE(parallel.getStats(from, to).min == serial.getStats(from, to).min);
+        REQUIRE(parallel.recomputeSum() == etObj1.getSum());
+        REQUIRE(parallel == etObj1);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("a database with an invalid category between valid ones") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{\"A\":{\"1\":{\"amount\":1.5,\"date\":\"2024-12-25\",\"description\":"
+        "\"a\",\"tags\":[]}},\"B\":{\"2\":{\"amount\":\"oops\"}},\"C\":{\"3\":"
+        "{\"amount\":2.5,\"date\":\"2024-12-25\",\"description\":\"c\","
+        "\"tags\":[]}}}"));
+
+    WHEN("it is opened lazily by a parallel ExpenseTracker and summed") {
+
+      ExpenseTracker etObj1{};
+      etObj1.setThreads(3);
+      REQUIRE_NOTHROW(etObj1.open(filePath));
+      REQUIRE_THROWS_AS(etObj1.getSum(), std::runtime_error);
+
+      THEN("it is left as summing serially would leave it") {
+
+        REQUIRE(etObj1.size() == 3);
+        REQUIRE(etObj1.deleteCategory("B"));
+        REQUIRE(etObj1.getSum() == 4.0);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("The threads program argument does not change the output", "[args]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+        "\"description\":\"Laptop\",\"tags\":[\"uni\"]},\"2\":{\"amount\":"
+        "39.99,\"date\":\"2024-11-20\",\"description\":\"C++ Book\",\"tags\":"
+        "[]}},\"Travel\":{\"3\":{\"amount\":164.0,\"date\":\"2024-12-30\","
+        "\"description\":\"Bus Pass\",\"tags\":[\"bus\",\"uni\"]}}}"));
+
+    WHEN("the action is stats with a threads argument") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "stats",
+                    "--threads", "4"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("the same statistics are printed as with one thread") {
+
+        REQUIRE(buffer.str() == "count: 3\nsum: 1203.98\nmin: 39.99\n"
+                                "max: 999.99\nmean: 401.33\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,247 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for grouped reports, including
+// the report action and the group-by and output program
+// arguments.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+#include "../src/report.h"
+#include "../src/writer.h"
+
+// Redirect std::cout to a buffer
+// by Björn Pollex
+// via https://stackoverflow.com/a/5419388
+// licensed under CC BY-SA 3.0.
+class CoutRedirect {
+private:
+  std::streambuf *old;
+
+public:
+  CoutRedirect(std::streambuf *new_buffer)
+      : old(std::cout.rdbuf(new_buffer)) { /* do nothing */
+  }
+
+  ~CoutRedirect() { std::cout.rdbuf(old); }
+};
+
+SCENARIO("A group-by list can be parsed", "[report]") {
+
+  THEN("known dimensions are accepted in the order given") {
+
+    const auto groupBy = Report::parseGroupBy("Tag,month");
+    REQUIRE(groupBy.size() == 2);
+    REQUIRE(groupBy[0] == Report::TAG);
+    REQUIRE(groupBy[1] == Report::MONTH);
+
+  } // THEN
+
+  THEN("empty, unknown and repeated dimensions are rejected") {
+
+    REQUIRE_THROWS_AS(Report::parseGroupBy(""), std::invalid_argument);
+    REQUIRE_THROWS_AS(Report::parseGroupBy("month,"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Report::parseGroupBy("week"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Report::parseGroupBy("tag,tag"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Report::parseGroupBy("m\xC3\xB6nth"), std::invalid_argument);
+
+  } // THEN
+
+}
+
+SCENARIO("A Report groups items by month, category and tag", "[report]") {
+
+  GIVEN("an ExpenseTracker with items across months and categories") {
+
+    ExpenseTracker etObj{};
+    Category &studies = etObj.newCategory("Studies");
+    studies.newItem("1", "Laptop", 999.99, Date(2024, 12, 25)).addTag("uni");
+    studies.newItem("2", "Book", 39.99, Date(2024, 11, 20));
+    Category &travel = etObj.newCategory("Travel");
+    Item &pass = travel.newItem("3", "Bus Pass", 164.0, Date(2024, 12, 30));
+    pass.addTag("bus");
+    pass.addTag("uni");
+    travel.newItem("4", "Train", 20.5, Date(2025, 1, 2)).addTag("uni");
+
+    const ExpenseTracker::ItemSelector all = [](const Category &cObj) {
+      return cObj.getItems(Date::earliest(), Date::latest());
+    };
+
+    WHEN("it is grouped by month") {
+
+      const Report report = etObj.report({Report::MONTH}, "", all);
+      StringWriter out;
+      report.write(out);
+
+      THEN("each month holds the count and sum of its items") {
+
+        REQUIRE(report.size() == 3);
+        REQUIRE(out.str() == "[{\"month\":\"2024-11\",\"count\":1,\"sum\":39.99},"
+                             "{\"month\":\"2024-12\",\"count\":2,\"sum\":1163.99},"
+                             "{\"month\":\"2025-01\",\"count\":1,\"sum\":20.5}]");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("it is grouped by category and tag with four threads") {
+
+      etObj.setThreads(4);
+      const Report report = etObj.report({Report::CATEGORY, Report::TAG}, "", all);
+      StringWriter out;
+      report.writeCsv(out);
+
+      THEN("items are counted under each of their tags, or the empty tag") {
+
+        REQUIRE(out.str() == "category,tag,count,sum\n"
+                             "Studies,,1,39.99\n"
+                             "Studies,uni,1,999.99\n"
+                             "Travel,bus,1,164.0\n"
+                             "Travel,uni,2,184.5\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("it is grouped by tag with only one tag kept") {
+
+      const Report report = etObj.report({Report::TAG}, "uni", all);
+      StringWriter out;
+      report.writeCsv(out);
+
+      THEN("only that tag has a group") {
+
+        REQUIRE(out.str() == "tag,count,sum\nuni,3,1184.49\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("a category whose name needs quoting in CSV") {
+
+    ExpenseTracker etObj{};
+    etObj.newCategory("Food, \"Drink\"")
+        .newItem("1", "Tea", 2.5, Date(2024, 12, 31));
+
+    WHEN("it is grouped by category and written as CSV") {
+
+      const Report report = etObj.report(
+          {Report::CATEGORY}, "",
+          [](const Category &cObj) { return cObj.getItems(Date::earliest(), Date::latest()); });
+      StringWriter out;
+      report.writeCsv(out);
+
+      THEN("the name is quoted and its quotes doubled") {
+
+        REQUIRE(out.str() == "category,count,sum\n\"Food, \"\"Drink\"\"\",1,2.5\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("The report action prints grouped counts and sums", "[args]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+        "\"description\":\"Laptop\",\"tags\":[\"uni\"]},\"2\":{\"amount\":"
+        "39.99,\"date\":\"2024-11-20\",\"description\":\"C++ Book\",\"tags\":"
+        "[]}},\"Travel\":{\"3\":{\"amount\":164.0,\"date\":\"2024-12-30\","
+        "\"description\":\"Bus Pass\",\"tags\":[\"bus\",\"uni\"]}}}"));
+
+    WHEN("the action is report grouped by month and category") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "report",
+                    "--group-by", "month,category"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("the groups are printed as JSON") {
+
+        REQUIRE(buffer.str() ==
+                "[{\"month\":\"2024-11\",\"category\":\"Studies\",\"count\":1,\"sum\":39.99},"
+                "{\"month\":\"2024-12\",\"category\":\"Studies\",\"count\":1,\"sum\":999.99},"
+                "{\"month\":\"2024-12\",\"category\":\"Travel\",\"count\":1,\"sum\":164.0}]\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is report for a category and date range as CSV") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "report",
+                    "--group-by", "month", "--category", "Studies", "--from",
+                    "2024-12-01", "--output", "csv"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("only the chosen items are grouped") {
+
+        REQUIRE(buffer.str() == "month,count,sum\n2024-12,1,999.99\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is report without a group-by argument") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "report"});
+
+      std::stringstream buffer;
+      std::stringstream errBuffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      std::streambuf *oldErr = std::cerr.rdbuf(errBuffer.rdbuf());
+      const int result = App::run(argvObj.argc(), argvObj.argv());
+      std::cerr.rdbuf(oldErr);
+
+      THEN("an error is printed") {
+
+        REQUIRE(result == 1);
+        REQUIRE(errBuffer.str() == "Error: missing group-by argument(s).\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,218 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for finding the largest and
+// most recent expenses, including the top action and the
+// by and limit program arguments.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+#include "../src/top.h"
+#include "../src/writer.h"
+
+// Redirect std::cout to a buffer
+// by Björn Pollex
+// via https://stackoverflow.com/a/5419388
+// licensed under CC BY-SA 3.0.
+class CoutRedirect {
+private:
+  std::streambuf *old;
+
+public:
+  CoutRedirect(std::streambuf *new_buffer)
+      : old(std::cout.rdbuf(new_buffer)) { /* do nothing */
+  }
+
+  ~CoutRedirect() { std::cout.rdbuf(old); }
+};
+
+SCENARIO("A Top keeps the highest ranked expenses", "[top]") {
+
+  const ExpenseTracker::ItemSelector all = [](const Category &cObj) {
+    return cObj.getItems(Date::earliest(), Date::latest());
+  };
+
+  GIVEN("an ExpenseTracker with many items across categories") {
+
+    ExpenseTracker etObj{};
+    std::vector<const Item *> items;
+    for (int c = 0; c < 7; c++) {
+      Category &cObj = etObj.newCategory("Category" + std::to_string(c));
+      for (int i = 0; i < 60; i++) {
+        // Amounts and dates repeat, so ties must be broken consistently.
+        Item &iObj = cObj.newItem(std::to_string(i), "Item", 0.25 * ((c * 37 + i * 11) % 50),
+                                  Date(2024, 1 + (c + i) % 12, 1 + i % 28));
+        items.push_back(&iObj);
+      }
+    }
+
+    auto fullSort = [&items](Top::Order by) {
+      std::vector<const Item *> sorted = items;
+      std::sort(sorted.begin(), sorted.end(), [by](const Item *a, const Item *b) {
+        if (by == Top::AMOUNT && !(a->getAmount() == b->getAmount())) {
+          return b->getAmount() < a->getAmount();
+        }
+        if (!(a->getDate() == b->getDate())) {
+          return b->getDate() < a->getDate();
+        }
+        return b->getAmount() < a->getAmount();
+      });
+      return sorted;
+    };
+
+    THEN("the largest amounts are found in order, whatever the number of threads") {
+
+      const std::vector<const Item *> expected = fullSort(Top::AMOUNT);
+      for (unsigned int threads : {1u, 4u}) {
+        etObj.setThreads(threads);
+        const std::vector<const Item *> found = etObj.top(Top::AMOUNT, 25, all).items();
+        REQUIRE(found.size() == 25);
+        for (std::size_t i = 0; i < found.size(); i++) {
+          REQUIRE(found[i]->getAmount() == expected[i]->getAmount());
+          REQUIRE(found[i]->getDate() == expected[i]->getDate());
+        }
+        REQUIRE(etObj.top(Top::AMOUNT, 25, all).items() == found);
+      }
+
+    } // THEN
+
+    THEN("the most recent dates are found in order") {
+
+      const std::vector<const Item *> expected = fullSort(Top::DATE);
+      const std::vector<const Item *> found = etObj.top(Top::DATE, 40, all).items();
+      REQUIRE(found.size() == 40);
+      for (std::size_t i = 0; i < found.size(); i++) {
+        REQUIRE(found[i]->getDate() == expected[i]->getDate());
+        REQUIRE(found[i]->getAmount() == expected[i]->getAmount());
+      }
+
+    } // THEN
+
+    THEN("a limit beyond the number of items keeps them all, and 0 keeps none") {
+
+      REQUIRE(etObj.top(Top::DATE, 1000, all).size() == items.size());
+      REQUIRE(etObj.top(Top::AMOUNT, 0, all).size() == 0);
+
+    } // THEN
+
+  } // GIVEN
+
+  THEN("orders can be parsed") {
+
+    REQUIRE(Top::parseOrder("Amount") == Top::AMOUNT);
+    REQUIRE(Top::parseOrder("date") == Top::DATE);
+    REQUIRE_THROWS_AS(Top::parseOrder("size"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Top::parseOrder("d\xC3\xA4te"), std::invalid_argument);
+
+  } // THEN
+
+}
+
+SCENARIO("The top action prints the largest or most recent expenses", "[args]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+        "\"description\":\"Laptop\",\"tags\":[\"uni\"]},\"2\":{\"amount\":"
+        "39.99,\"date\":\"2024-11-20\",\"description\":\"C++ Book\",\"tags\":"
+        "[]}},\"Travel\":{\"3\":{\"amount\":164.0,\"date\":\"2024-12-30\","
+        "\"description\":\"Bus Pass\",\"tags\":[\"bus\",\"uni\"]}}}"));
+
+    WHEN("the action is top with a limit") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "top",
+                    "--limit", "2"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("the largest expenses are printed as JSON") {
+
+        REQUIRE(buffer.str() ==
+                "[{\"category\":\"Studies\",\"item\":\"1\",\"amount\":999.99,"
+                "\"date\":\"2024-12-25\",\"description\":\"Laptop\",\"tags\":"
+                "[\"uni\"]},{\"category\":\"Travel\",\"item\":\"3\",\"amount\":"
+                "164.0,\"date\":\"2024-12-30\",\"description\":\"Bus Pass\","
+                "\"tags\":[\"bus\",\"uni\"]}]\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is top by date for a category") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "top",
+                    "--by", "date", "--category", "Studies"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("the expenses of that category are printed, most recent first") {
+
+        REQUIRE(buffer.str() ==
+                "[{\"category\":\"Studies\",\"item\":\"1\",\"amount\":999.99,"
+                "\"date\":\"2024-12-25\",\"description\":\"Laptop\",\"tags\":"
+                "[\"uni\"]},{\"category\":\"Studies\",\"item\":\"2\",\"amount\":"
+                "39.99,\"date\":\"2024-11-20\",\"description\":\"C++ Book\","
+                "\"tags\":[]}]\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is top with a tag and an invalid category") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "top",
+                    "--tag", "uni", "--category", "Food"});
+
+      std::stringstream buffer;
+      std::stringstream errBuffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      std::streambuf *oldErr = std::cerr.rdbuf(errBuffer.rdbuf());
+      const int result = App::run(argvObj.argc(), argvObj.argv());
+      std::cerr.rdbuf(oldErr);
+
+      THEN("an error is printed") {
+
+        REQUIRE(result == 1);
+        REQUIRE(errBuffer.str() == "Error: invalid category argument(s).\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,210 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for searching item descriptions,
+// including the search action and the query program
+// argument.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+
+// Redirect std::cout to a buffer
+// by Björn Pollex
+// via https://stackoverflow.com/a/5419388
+// licensed under CC BY-SA 3.0.
+class CoutRedirect {
+private:
+  std::streambuf *old;
+
+public:
+  CoutRedirect(std::streambuf *new_buffer)
+      : old(std::cout.rdbuf(new_buffer)) { /* do nothing */
+  }
+
+  ~CoutRedirect() { std::cout.rdbuf(old); }
+};
+
+SCENARIO("Item descriptions can be searched ignoring case", "[category]") {
+
+  auto idents = [](const std::vector<const Item *> &items) {
+    std::vector<std::string> result;
+    for (const Item *item : items) {
+      result.push_back(item->getIdent());
+    }
+    return result;
+  };
+
+  GIVEN("a Category with several items") {
+
+    Category cObj{"Food"};
+    cObj.newItem("1", "Costa Coffee", 2.55, Date(2024, 12, 3));
+    cObj.newItem("2", "costa lunch", 6.2, Date(2024, 12, 1));
+    cObj.newItem("3", "Tesco", 12.0, Date(2024, 12, 2));
+    cObj.newItem("4", "Coffee beans", 8.0, Date(2024, 12, 2));
+
+    THEN("substrings are found in any case, ordered by date") {
+
+      REQUIRE(idents(cObj.search("COSTA")) == std::vector<std::string>{"2", "1"});
+      REQUIRE(idents(cObj.search("coffee")) == std::vector<std::string>{"4", "1"});
+      REQUIRE(idents(cObj.search("sta lu")) == std::vector<std::string>{"2"});
+      REQUIRE(idents(cObj.search("co")) == std::vector<std::string>{"2", "3", "4", "1"});
+      REQUIRE(cObj.search("tea").empty());
+      REQUIRE(cObj.search("costa tea").empty());
+
+    } // THEN
+
+    THEN("the trigram index is built on the second search of three or more characters") {
+
+      REQUIRE(cObj.search("co").size() == 4);
+      REQUIRE_FALSE(cObj.hasSearchIndex());
+      REQUIRE(cObj.search("costa").size() == 2);
+      REQUIRE_FALSE(cObj.hasSearchIndex());
+      REQUIRE(cObj.search("costa").size() == 2);
+      REQUIRE(cObj.hasSearchIndex());
+
+    } // THEN
+
+    WHEN("descriptions change and items are added and deleted after the index is built") {
+
+      REQUIRE(cObj.search("costa").size() == 2);
+      REQUIRE(cObj.search("costa").size() == 2);
+      REQUIRE(cObj.hasSearchIndex());
+      cObj.getItem("1").setDescription("Starbucks");
+      cObj.newItem("5", "Costa Express", 3.1, Date(2024, 12, 5));
+      cObj.addItem(Item("6", "Pret", 4.0, Date(2024, 12, 6)));
+      REQUIRE(cObj.deleteItem("2"));
+      cObj.newItem("4", "Costa beans", 8.0, Date(2024, 12, 2));
+
+      THEN("searches see the changes") {
+
+        REQUIRE(idents(cObj.search("costa")) == std::vector<std::string>{"4", "5"});
+        REQUIRE(idents(cObj.search("STARBUCKS")) == std::vector<std::string>{"1"});
+        REQUIRE(idents(cObj.search("pret")) == std::vector<std::string>{"6"});
+        REQUIRE(cObj.search("coffee").empty());
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the Category is copied after the index is built") {
+
+      REQUIRE(cObj.search("costa").size() == 2);
+      REQUIRE(cObj.search("costa").size() == 2);
+      Category copy{cObj};
+      copy.getItem("3").setDescription("Costa Tesco");
+
+      THEN("the copy searches its own items") {
+
+        REQUIRE(idents(copy.search("costa")) == std::vector<std::string>{"2", "3", "1"});
+        REQUIRE(copy.search("costa")[0] == &copy.getItem("2"));
+        REQUIRE(cObj.search("costa").size() == 2);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("The search action prints the expenses matching a query", "[args]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{\"Food\":{\"1\":{\"amount\":2.55,\"date\":\"2024-12-03\","
+        "\"description\":\"Costa Coffee\",\"tags\":[\"uni\"]},\"2\":{\"amount\":"
+        "6.2,\"date\":\"2024-11-20\",\"description\":\"Tesco\",\"tags\":"
+        "[]}},\"Travel\":{\"3\":{\"amount\":3.0,\"date\":\"2024-12-30\","
+        "\"description\":\"Coffee on the train\",\"tags\":[\"bus\"]}}}"));
+
+    WHEN("the action is search with a query") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "search",
+                    "--query", "COFFEE"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("the matching expenses are printed as JSON") {
+
+        REQUIRE(buffer.str() ==
+                "{\"Food\":{\"1\":{\"amount\":2.55,\"date\":\"2024-12-03\","
+                "\"description\":\"Costa Coffee\",\"tags\":[\"uni\"]}},\"Travel\":"
+                "{\"3\":{\"amount\":3.0,\"date\":\"2024-12-30\",\"description\":"
+                "\"Coffee on the train\",\"tags\":[\"bus\"]}}}\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is search with a tag") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "search",
+                    "--query", "coffee", "--tag", "bus"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("only matching expenses with the tag are printed") {
+
+        REQUIRE(buffer.str() ==
+                "{\"Travel\":{\"3\":{\"amount\":3.0,\"date\":\"2024-12-30\","
+                "\"description\":\"Coffee on the train\",\"tags\":[\"bus\"]}}}\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is search without a query") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "search"});
+
+      std::stringstream buffer;
+      std::stringstream errBuffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      std::streambuf *oldErr = std::cerr.rdbuf(errBuffer.rdbuf());
+      const int result = App::run(argvObj.argc(), argvObj.argv());
+      std::cerr.rdbuf(oldErr);
+
+      THEN("an error is printed") {
+
+        REQUIRE(result == 1);
+        REQUIRE(errBuffer.str() == "Error: missing query argument(s).\n");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
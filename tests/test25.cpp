@@ -0,0 +1,248 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for filter expressions,
+// including the where program argument.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/lib_cxxopts.hpp"
+#include "../src/lib_cxxopts_argv.hpp"
+
+#include "../src/371expenses.h"
+#include "../src/filter.h"
+
+// Redirect std::cout to a buffer
+// by Björn Pollex
+// via https://stackoverflow.com/a/5419388
+// licensed under CC BY-SA 3.0.
+class CoutRedirect {
+private:
+  std::streambuf *old;
+
+public:
+  CoutRedirect(std::streambuf *new_buffer)
+      : old(std::cout.rdbuf(new_buffer)) { /* do nothing */
+  }
+
+  ~CoutRedirect() { std::cout.rdbuf(old); }
+};
+
+SCENARIO("A Filter selects the items matching an expression", "[filter]") {
+
+  auto idents = [](const std::vector<const Item *> &items) {
+    std::vector<std::string> result;
+    for (const Item *item : items) {
+      result.push_back(item->getIdent());
+    }
+    return result;
+  };
+
+  GIVEN("a Category with several items") {
+
+    Category cObj{"Food"};
+    cObj.newItem("1", "Costa Coffee", 2.55, Date(2024, 12, 3)).addTag("uni");
+    Item &lunch = cObj.newItem("2", "Lunch at Costa", 26.2, Date(2024, 12, 1));
+    lunch.addTag("uni");
+    lunch.addTag("treat");
+    cObj.newItem("3", "Tesco", 42.0, Date(2024, 11, 2));
+    cObj.newItem("4", "Coffee beans", 21.0, Date(2025, 1, 2)).addTag("home");
+
+    const Date from = Date::earliest();
+    const Date to = Date::latest();
+    auto select = [&](const std::string &expression) {
+      return idents(Filter(expression).select(cObj, from, to));
+    };
+
+    THEN("single conditions match") {
+
+      REQUIRE(select("amount > 21") == std::vector<std::string>{"3", "2"});
+      REQUIRE(select("amount >= 21") == std::vector<std::string>{"3", "2", "4"});
+      REQUIRE(select("amount == 2.55") == std::vector<std::string>{"1"});
+      REQUIRE(select("date < 2024-12-03") == std::vector<std::string>{"3", "2"});
+      REQUIRE(select("date != 2024-12-03") == std::vector<std::string>{"3", "2", "4"});
+      REQUIRE(select("tag:uni") == std::vector<std::string>{"2", "1"});
+      REQUIRE(select("desc ~ \"COSTA\"") == std::vector<std::string>{"2", "1"});
+      REQUIRE(select("description == \"tesco\"") == std::vector<std::string>{"3"});
+      REQUIRE(select("") == std::vector<std::string>{"3", "2", "1", "4"});
+
+    } // THEN
+
+    THEN("conditions combine with precedence and brackets") {
+
+      REQUIRE(select("amount > 20 && tag:uni && date >= 2024-01-01 && desc ~ \"costa\"") ==
+              std::vector<std::string>{"2"});
+      REQUIRE(select("tag:home || tag:treat && amount < 10") == std::vector<std::string>{"4"});
+      REQUIRE(select("(tag:home || tag:treat) && amount > 10") ==
+              std::vector<std::string>{"2", "4"});
+      REQUIRE(select("!tag:uni && !(desc ~ bea)") == std::vector<std::string>{"3"});
+      REQUIRE(select("date > 2024-12-01 && date < 2025-01-02") == std::vector<std::string>{"1"});
+
+    } // THEN
+
+    THEN("the selection is further limited by a date range and tag") {
+
+      REQUIRE(idents(Filter("desc ~ costa").select(cObj, Date(2024, 12, 2), to)) ==
+              std::vector<std::string>{"1"});
+      REQUIRE(idents(Filter("amount > 1").select(cObj, from, to, "treat")) ==
+              std::vector<std::string>{"2"});
+
+    } // THEN
+
+    THEN("descriptions are checked in place until the trigram index is built") {
+
+      REQUIRE(select("desc ~ \"COSTA\"") == std::vector<std::string>{"2", "1"});
+      REQUIRE(select("desc ~ \"COSTA\"") == std::vector<std::string>{"2", "1"});
+      REQUIRE_FALSE(cObj.hasSearchIndex());
+      REQUIRE(cObj.search("costa").size() == 2);
+      REQUIRE(cObj.search("costa").size() == 2);
+      REQUIRE(cObj.hasSearchIndex());
+      REQUIRE(select("desc ~ \"COSTA\"") == std::vector<std::string>{"2", "1"});
+
+    } // THEN
+
+    THEN("invalid expressions are rejected") {
+
+      REQUIRE_THROWS_AS(Filter("amount >"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Filter("amount ~ 5"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Filter("colour == red"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Filter("(tag:uni"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Filter("tag:uni tag:home"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Filter("desc ~ \"costa"), std::invalid_argument);
+      REQUIRE_THROWS_AS(Filter("date > 2024-13-01"), std::invalid_argument);
+
+    } // THEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("The where program argument limits and chooses expenses", "[args]") {
+
+  const std::string filePath = "./tests/testdatabasealt.json";
+
+  auto writeFileContents = [](const std::string &path,
+                              const std::string &contents) {
+    std::ofstream f{path};
+    f << contents;
+  };
+
+  GIVEN("a valid path to a reset database JSON file") {
+
+    REQUIRE_NOTHROW(writeFileContents(
+        filePath,
+        "{\"Studies\":{\"1\":{\"amount\":999.99,\"date\":\"2024-12-25\","
+        "\"description\":\"Laptop\",\"tags\":[\"uni\"]},\"2\":{\"amount\":"
+        "39.99,\"date\":\"2024-11-20\",\"description\":\"C++ Book\",\"tags\":"
+        "[]}},\"Travel\":{\"3\":{\"amount\":164.0,\"date\":\"2024-12-30\","
+        "\"description\":\"Bus Pass\",\"tags\":[\"bus\",\"uni\"]}}}"));
+
+    WHEN("the action is sum with a where argument") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "sum",
+                    "--where", "amount < 500 || desc ~ lap"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("the matching expenses are summed") {
+
+        REQUIRE(buffer.str() == "1203.98\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is json for a category with a where argument") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "json",
+                    "--category", "Studies", "--where", "!tag:uni"});
+
+      std::stringstream buffer;
+      CoutRedirect originalBuffer{buffer.rdbuf()};
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("only the matching expenses are printed") {
+
+        REQUIRE(buffer.str() ==
+                "{\"2\":{\"amount\":39.99,\"date\":\"2024-11-20\",\"description\":"
+                "\"C++ Book\",\"tags\":[]}}\n");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is update with a where argument") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "update",
+                    "--where", "tag:uni", "--tag", "claimed"});
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("every matching expense is updated and saved") {
+
+        ExpenseTracker etObj{};
+        etObj.load(filePath);
+        REQUIRE(etObj.getCategory("Studies").getItem("1").containsTag("claimed"));
+        REQUIRE_FALSE(etObj.getCategory("Studies").getItem("2").containsTag("claimed"));
+        REQUIRE(etObj.getCategory("Travel").getItem("3").containsTag("claimed"));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is delete with a where argument") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "delete",
+                    "--where", "date >= 2024-12-01"});
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("every matching expense is deleted and the rest saved") {
+
+        ExpenseTracker etObj{};
+        etObj.load(filePath);
+        REQUIRE(etObj.getCategory("Studies").size() == 1);
+        REQUIRE(etObj.getCategory("Studies").getItem("2").getDescription() == "C++ Book");
+        REQUIRE(etObj.getCategory("Travel").size() == 0);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the action is delete with a where and tag argument for a category") {
+
+      Argv argvObj({"test", "--db", filePath.c_str(), "--action", "delete",
+                    "--category", "Travel", "--where", "amount > 100",
+                    "--tag", "uni"});
+      REQUIRE(App::run(argvObj.argc(), argvObj.argv()) == 0);
+
+      THEN("the tag is deleted from the matching expenses of that category only") {
+
+        ExpenseTracker etObj{};
+        etObj.load(filePath);
+        REQUIRE_FALSE(etObj.getCategory("Travel").getItem("3").containsTag("uni"));
+        REQUIRE(etObj.getCategory("Travel").getItem("3").containsTag("bus"));
+        REQUIRE(etObj.getCategory("Studies").getItem("1").containsTag("uni"));
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,145 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for the FlatMap and HashMap
+// containers, which must behave like std::map for the
+// parts of its interface that categories and items use.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/containers.h"
+
+// Applies the same random inserts and erases to a map and to std::map, checking
+// after each step that they hold the same entries in the same order and that
+// values never move.
+template <typename Map> static void compareWithStdMap() {
+  Map map;
+  std::map<std::string, int> expected;
+  std::map<std::string, const int *> addresses;
+  std::mt19937 rng(371);
+
+  for (int step = 0; step < 3000; step++) {
+    const std::string key = std::to_string(rng() % 500);
+    if (rng() % 3 == 0) {
+      auto it = map.find(key);
+      REQUIRE((it == map.end()) == (expected.count(key) == 0));
+      if (it != map.end()) {
+        map.erase(it);
+        expected.erase(key);
+        addresses.erase(key);
+      }
+    } else {
+      auto result = map.insert(std::make_pair(key, step));
+      auto original = expected.insert(std::make_pair(key, step));
+      REQUIRE(result.second == original.second);
+      REQUIRE(result.first->first == key);
+      REQUIRE(result.first->second == original.first->second);
+      if (result.second) {
+        addresses[key] = &result.first->second;
+      }
+    }
+    REQUIRE(map.size() == expected.size());
+    REQUIRE(map.count(key) == expected.count(key));
+    if (step % 100 == 0) {
+      auto e = expected.begin();
+      for (const auto &pair : map) {
+        REQUIRE(pair.first == e->first);
+        REQUIRE(pair.second == e->second);
+        REQUIRE(&pair.second == addresses[pair.first]);
+        ++e;
+      }
+      REQUIRE(e == expected.end());
+    }
+  }
+}
+
+SCENARIO("FlatMap and HashMap behave like std::map", "[containers]") {
+
+  THEN("random inserts and erases give the same entries as std::map") {
+
+    compareWithStdMap<FlatMap<std::string, int>>();
+    compareWithStdMap<HashMap<std::string, int>>();
+
+  } // THEN
+
+  GIVEN("a HashMap with keys inserted out of order") {
+
+    HashMap<std::string, std::string> map;
+    for (const char *key : {"pear", "apple", "fig", "banana"}) {
+      map.insert(std::make_pair(key, std::string(key) + "s"));
+    }
+
+    THEN("it iterates in key order and can be looked up") {
+
+      std::vector<std::string> keys;
+      for (const auto &pair : map) {
+        keys.push_back(pair.first);
+      }
+      REQUIRE(keys == std::vector<std::string>{"apple", "banana", "fig", "pear"});
+      REQUIRE(map.find("fig")->second == "figs");
+      REQUIRE(map.find("kiwi") == map.end());
+      REQUIRE_FALSE(map.insert(std::make_pair("fig", "dates")).second);
+      REQUIRE(map.find("fig")->second == "figs");
+
+    } // THEN
+
+    WHEN("it is copied and the copy changed") {
+
+      HashMap<std::string, std::string> copy(map);
+      copy.erase(copy.find("apple"));
+      copy.insert(std::make_pair("cherry", "cherries"));
+
+      THEN("the original is unchanged and they are no longer equal") {
+
+        REQUIRE(map.size() == 4);
+        REQUIRE(map.count("apple") == 1);
+        REQUIRE(map.count("cherry") == 0);
+        REQUIRE(copy.begin()->first == "banana");
+        REQUIRE(map != copy);
+        copy.insert(std::make_pair("apple", "apples"));
+        copy.erase(copy.find("cherry"));
+        REQUIRE(map == copy);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("a FlatMap") {
+
+    FlatMap<std::string, int> map;
+    map.insert(std::make_pair("b", 2));
+    map.insert(std::make_pair("a", 1));
+    map.insert(std::make_pair("c", 3));
+
+    THEN("erasing by iterator gives the next entry") {
+
+      auto next = map.erase(map.find("b"));
+      REQUIRE(next->first == "c");
+      REQUIRE(map.begin()->first == "a");
+      REQUIRE(map.size() == 2);
+      map.clear();
+      REQUIRE(map.empty());
+      REQUIRE(map.begin() == map.end());
+
+    } // THEN
+
+  } // GIVEN
+
+}
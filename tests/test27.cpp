@@ -0,0 +1,172 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for interned tags: the
+// TagDictionary, the TagList of ids held by each Item
+// and the TagNames view of it.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/expensetracker.h"
+#include "../src/filter.h"
+
+SCENARIO("Tags are interned to small integer ids", "[tags]") {
+
+  GIVEN("some tag strings") {
+
+    const TagId uni = TagDictionary::intern("uni");
+    const TagId home = TagDictionary::intern("home");
+
+    THEN("each string has one id, which gives the string back") {
+
+      REQUIRE(uni != home);
+      REQUIRE(TagDictionary::intern(std::string("uni")) == uni);
+      REQUIRE(TagDictionary::name(uni) == "uni");
+      REQUIRE(TagDictionary::name(home) == "home");
+
+      TagId id = 0;
+      REQUIRE(TagDictionary::find("home", id));
+      REQUIRE(id == home);
+      REQUIRE_FALSE(TagDictionary::find("a tag never seen by test27", id));
+
+    } // THEN
+
+  } // GIVEN
+
+  GIVEN("a TagList") {
+
+    TagList list;
+
+    WHEN("more ids are added than fit in the object, then removed") {
+
+      for (TagId id = 10; id < 17; id++) {
+        REQUIRE(list.add(id));
+      }
+      REQUIRE_FALSE(list.add(12));
+
+      THEN("the ids keep their order as they move to the vector and back") {
+
+        REQUIRE(list.size() == 7);
+        REQUIRE(std::vector<TagId>(list.begin(), list.end()) ==
+                std::vector<TagId>{10, 11, 12, 13, 14, 15, 16});
+        REQUIRE(list.remove(10));
+        REQUIRE(list.remove(13));
+        REQUIRE(list.remove(16));
+        REQUIRE_FALSE(list.remove(16));
+        REQUIRE(std::vector<TagId>(list.begin(), list.end()) ==
+                std::vector<TagId>{11, 12, 14, 15});
+        REQUIRE(list.contains(14));
+        REQUIRE_FALSE(list.contains(13));
+
+        TagList other;
+        for (TagId id : {11, 12, 14, 15}) {
+          other.add(id);
+        }
+        REQUIRE(list == other);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("Items keep their tags as ids and show them as strings", "[tags]") {
+
+  GIVEN("an Item in a Category with several tags") {
+
+    Category cObj{"Food"};
+    Item &item = cObj.newItem("1", "Costa Coffee", 2.55, Date(2024, 12, 3));
+    const std::vector<std::string> tags{"uni", "coffee", "treat", "morning",
+                                        "costa", "cafe"};
+    for (const auto &tag : tags) {
+      REQUIRE(item.addTag(tag));
+    }
+    REQUIRE_FALSE(item.addTag("treat"));
+
+    THEN("the tags are seen as strings in the order they were added") {
+
+      REQUIRE(item.numTags() == tags.size());
+      REQUIRE(item.getTags() == tags);
+      REQUIRE(item.getTags()[2] == "treat");
+      REQUIRE(item.getTagIds().size() == tags.size());
+      REQUIRE(*item.getTagIds().begin() == TagDictionary::intern("uni"));
+      REQUIRE(item.str() == "{\"amount\":2.55,\"date\":\"2024-12-03\",\"description\":"
+                            "\"Costa Coffee\",\"tags\":[\"uni\",\"coffee\",\"treat\","
+                            "\"morning\",\"costa\",\"cafe\"]}");
+
+    } // THEN
+
+    THEN("tags can be found and deleted by string or id") {
+
+      REQUIRE(item.containsTag("coffee"));
+      REQUIRE(item.containsTagId(TagDictionary::intern("morning")));
+      REQUIRE_FALSE(item.containsTag("a tag never seen by test27 either"));
+      REQUIRE_THROWS_AS(item.deleteTag("a tag never seen by test27 either"),
+                        std::out_of_range);
+      REQUIRE(item.deleteTag("coffee"));
+      REQUIRE_FALSE(item.containsTag("coffee"));
+      REQUIRE(cObj.getItemsWithTag("coffee").empty());
+      REQUIRE(cObj.getItemsWithTag("cafe").size() == 1);
+      REQUIRE(item.addTagId(TagDictionary::intern("coffee")));
+      REQUIRE(cObj.getSumForTag("coffee") == Money(2.55));
+
+    } // THEN
+
+    THEN("querying tags that no item carries does not intern them") {
+
+      const std::size_t before = TagDictionary::size();
+      const Filter where("tag:\"a tag only queried by test27\" || amount > 1");
+      REQUIRE(where.select(cObj, Date::earliest(), Date::latest()).size() == 1);
+      REQUIRE(where.select(cObj, Date::earliest(), Date::latest(),
+                           "another tag only queried by test27").empty());
+      Report report({Report::TAG}, "a third tag only queried by test27");
+      report.add(cObj, cObj.getItems(Date::earliest(), Date::latest()));
+      REQUIRE(report.size() == 0);
+      REQUIRE(TagDictionary::size() == before);
+
+      Report byTag({Report::TAG}, "");
+      byTag.add(cObj, cObj.getItems(Date::earliest(), Date::latest()));
+      REQUIRE(byTag.size() == tags.size());
+      const Filter coffee("tag:coffee");
+      REQUIRE(coffee.matches(item, coffee.findTags()));
+
+    } // THEN
+
+    WHEN("the Category is saved and loaded as a binary snapshot") {
+
+      const std::string filePath = "./tests/testdatabasealt.bin";
+      ExpenseTracker etObj{};
+      etObj.addCategory(cObj);
+      etObj.saveBinary(filePath);
+      ExpenseTracker loaded{};
+      loaded.loadBinary(filePath);
+      std::remove(filePath.c_str());
+
+      THEN("the tags are the same") {
+
+        REQUIRE(loaded.getCategory("Food").getItem("1").getTags() == tags);
+        REQUIRE(loaded == etObj);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
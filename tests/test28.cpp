@@ -0,0 +1,126 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests for the Arena that categories
+// allocate their items from, and for categories copied
+// from and assigned to one another.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../src/arena.h"
+#include "../src/category.h"
+
+SCENARIO("An Arena hands out aligned memory until it is released", "[arena]") {
+
+  GIVEN("an empty Arena") {
+
+    Arena arena;
+    REQUIRE(arena.size() == 0);
+
+    WHEN("allocations of mixed sizes and alignments are made") {
+
+      std::vector<char *> blocks;
+      for (std::size_t i = 0; i < 1000; i++) {
+        const std::size_t alignment = std::size_t(1) << (i % 4);
+        char *p = static_cast<char *>(arena.allocate(i % 50 + 1, alignment));
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p) % alignment == 0);
+        p[0] = static_cast<char>(i);
+        p[i % 50] = static_cast<char>(i);
+        blocks.push_back(p);
+      }
+      char *large = static_cast<char *>(arena.allocate(100000, 8));
+      large[99999] = 'x';
+
+      THEN("they do not overlap and the Arena grows in chunks") {
+
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+          REQUIRE(blocks[i][0] == static_cast<char>(i));
+        }
+        REQUIRE(arena.size() >= 100000);
+
+        arena.release();
+        REQUIRE(arena.size() == 0);
+        REQUIRE(arena.allocate(16, 16) != nullptr);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a standard container allocates from it") {
+
+      std::map<int, std::string, std::less<int>,
+               ArenaAllocator<std::pair<const int, std::string>>>
+          map{ArenaAllocator<std::pair<const int, std::string>>(&arena)};
+      for (int i = 0; i < 100; i++) {
+        map[i] = std::to_string(i);
+      }
+
+      THEN("a copy of the container is on the heap") {
+
+        REQUIRE(arena.size() > 0);
+        auto copy = map;
+        REQUIRE(copy.get_allocator().getArena() == nullptr);
+        REQUIRE(copy == map);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("Copies of a Category do not share its memory", "[arena]") {
+
+  GIVEN("a Category with items and tags") {
+
+    Category *original = new Category("Food");
+    original->newItem("1", "A description too long to fit in a string object", 2.55,
+                      Date(2024, 12, 3))
+        .addTag("uni");
+    original->addItem(Item("2", "Another long description of an expense", 4.0,
+                           Date(2024, 12, 1)));
+    original->getItem("2").addTag("treat");
+
+    WHEN("it is copied and then destroyed") {
+
+      Category copy(*original);
+      Category assigned("Other");
+      assigned.newItem("9", "An item that the assignment replaces", 1.0, Date(2024, 1, 1));
+      assigned = *original;
+      delete original;
+
+      THEN("the copies keep their items") {
+
+        REQUIRE(copy.getItem("1").getDescription() ==
+                "A description too long to fit in a string object");
+        REQUIRE(copy.getItem("2").containsTag("treat"));
+        REQUIRE(copy.getItemsWithTag("uni").size() == 1);
+        REQUIRE(assigned.size() == 2);
+        REQUIRE_THROWS(assigned.getItem("9"));
+        REQUIRE(assigned.getItem("2").getDescription() ==
+                "Another long description of an expense");
+        REQUIRE(assigned.getSumForTag("treat") == Money(4.0));
+        REQUIRE(copy == assigned);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,223 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests that items and categories are
+// moved rather than copied into place, counting the heap
+// allocations made through operator new.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "../src/expensetracker.h"
+
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t size) {
+  allocations++;
+  if (void *p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+// Writes a database of one category with the given number of items, each
+// with a description too long to fit in a string object and one tag.
+static void writeDatabase(const std::string &filePath, std::size_t items) {
+  std::ofstream out(filePath);
+  out << "{\"Food\":{";
+  for (std::size_t i = 0; i < items; i++) {
+    out << (i == 0 ? "" : ",") << "\"" << i << "\":{\"amount\":" << i % 100
+        << ".5,\"date\":\"2024-12-0" << i % 9 + 1
+        << "\",\"description\":\"A description of expense number " << i
+        << "\",\"tags\":[\"tag" << i % 10 << "\"]}";
+  }
+  out << "}}";
+}
+
+// Returns the number of allocations made loading a database of the given size.
+static std::size_t allocationsLoading(std::size_t items) {
+  const std::string filePath = "./tests/testdatabasemoves.json";
+  writeDatabase(filePath, items);
+  const std::size_t before = allocations;
+  {
+    ExpenseTracker etObj{};
+    etObj.load(filePath);
+    REQUIRE(etObj.getCategory("Food").size() == items);
+  }
+  const std::size_t made = allocations - before;
+  std::remove(filePath.c_str());
+  return made;
+}
+
+SCENARIO("Loading a database allocates in proportion to its items", "[moves]") {
+
+  GIVEN("databases of 2000 and 4000 items") {
+
+    // The first load also interns the tags and sets up what is shared across loads.
+    allocationsLoading(100);
+    const std::size_t small = allocationsLoading(2000);
+    const std::size_t large = allocationsLoading(4000);
+
+    THEN("the extra items make no more allocations than each item's entry, description and tag") {
+
+      INFO(small << " allocations for 2000 items, " << large << " for 4000");
+      REQUIRE(large <= small + 3 * 2000);
+      REQUIRE(large <= 2 * small + 100);
+
+    } // THEN
+
+  } // GIVEN
+
+}
+
+SCENARIO("Items and categories are moved into place", "[moves]") {
+
+  GIVEN("a Category of 1000 items") {
+
+    Category cObj{"Food"};
+    for (int i = 0; i < 1000; i++) {
+      REQUIRE(cObj.emplaceItem(std::to_string(i), "A description too long to fit", Money(i), Date(2024, 12, 1)));
+      cObj.getItem(std::to_string(i)).addTag("food");
+    }
+    const Item *first = &cObj.getItem("0");
+
+    WHEN("it is moved into an ExpenseTracker") {
+
+      ExpenseTracker etObj{};
+      const std::size_t before = allocations;
+      const bool added = etObj.addCategory(std::move(cObj));
+      const std::size_t made = allocations - before;
+
+      THEN("its items are not copied and belong to the category in the tracker") {
+
+        REQUIRE(added);
+        REQUIRE(made < 16);
+        Category &moved = etObj.getCategory("Food");
+        REQUIRE(&moved.getItem("0") == first);
+        REQUIRE(moved.size() == 1000);
+        REQUIRE(moved.getItemsWithTag("food").size() == 1000);
+        moved.getItem("0").setAmount(Money(1000));
+        REQUIRE(moved.getSum() == Money(500500));
+        REQUIRE(etObj.getSum() == Money(500500));
+
+        REQUIRE(cObj.size() == 0);
+        REQUIRE(cObj.getSum() == Money(0));
+        cObj.newItem("1", "The category moved from can be used again", 1.0, Date(2024, 12, 2));
+        REQUIRE(cObj.getItem("1").getDescription() == "The category moved from can be used again");
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("another is move assigned to it") {
+
+      Category other{"Other"};
+      other.newItem("a", "An item of the category moved from", 5.0, Date(2024, 12, 3));
+      const Item *item = &other.getItem("a");
+      cObj = std::move(other);
+
+      THEN("it has the other's items in place of its own") {
+
+        REQUIRE(cObj.getIdent() == "Other");
+        REQUIRE(cObj.size() == 1);
+        REQUIRE(&cObj.getItem("a") == item);
+        cObj.getItem("a").setAmount(Money(6.0));
+        REQUIRE(cObj.getSum() == Money(6.0));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("a new Item is moved into it") {
+
+      Item iObj("new", "A description too long to fit in a string object", 2.0, Date(2024, 12, 4));
+      iObj.addTag("food");
+      const std::size_t before = allocations;
+      const bool added = cObj.addItem(std::move(iObj));
+      const std::size_t made = allocations - before;
+
+      THEN("only its map entry may be allocated") {
+
+        REQUIRE(added);
+        REQUIRE(made <= 2);
+        REQUIRE(cObj.getItem("new").getDescription() ==
+                "A description too long to fit in a string object");
+        REQUIRE(cObj.getItemsWithTag("food").size() == 1001);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("an Item with more tags than fit in place is moved") {
+
+      Item iObj("new", "A description too long to fit in a string object", 2.0, Date(2024, 12, 4));
+      for (const char *tag : {"a", "b", "c", "d", "e", "f"}) {
+        iObj.addTag(tag);
+      }
+      const std::size_t before = allocations;
+      Item moved(std::move(iObj));
+      Item assigned("other", "Other", 1.0, Date(2024, 12, 5));
+      assigned = std::move(moved);
+      const std::size_t made = allocations - before;
+
+      THEN("its tags are moved without allocating, and moving cannot throw") {
+
+        REQUIRE(made <= 1);
+        REQUIRE(assigned.numTags() == 6);
+        REQUIRE(assigned.containsTag("f"));
+        STATIC_REQUIRE(std::is_nothrow_move_constructible<Item>::value);
+        STATIC_REQUIRE(std::is_nothrow_move_constructible<Category>::value);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("an Item of another category is added to it") {
+
+      Category other{"Other"};
+      other.newItem("a", "An item that stays in the other category", 5.0, Date(2024, 12, 3));
+      cObj.addItem(std::move(other.getItem("a")));
+
+      THEN("the item is copied") {
+
+        REQUIRE(other.getItem("a").getDescription() == "An item that stays in the other category");
+        REQUIRE(cObj.getItem("a").getDescription() == "An item that stays in the other category");
+        REQUIRE(other.getSum() == Money(5.0));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("an item with an existing identifier is emplaced") {
+
+      THEN("the existing item is kept") {
+
+        REQUIRE_FALSE(cObj.emplaceItem("0", "Another description", Money(1.0), Date(2024, 1, 1)));
+        REQUIRE(cObj.getItem("0").getDescription() == "A description too long to fit");
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+}
@@ -0,0 +1,148 @@
+// -----------------------------------------------------
+// CSC371 Advanced Object Oriented Programming (2024/25)
+// Department of Computer Science, Swansea University
+//
+// Author: <2119504>
+//
+// Canvas: https://canvas.swansea.ac.uk/courses/52781
+// -----------------------------------------------------
+// Catch2 — https://github.com/catchorg/Catch2
+// Catch2 is licensed under the BOOST license
+// -----------------------------------------------------
+// This file contains tests that categories, items and tags
+// are looked up by std::string_view, and that lookups and
+// serialisation make no heap allocations.
+// -----------------------------------------------------
+
+#include "../src/lib_catch.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "../src/expensetracker.h"
+#include "../src/writer.h"
+
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t size) {
+  allocations++;
+  if (void *p = std::malloc(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+// Counts the bytes written to it rather than keeping them.
+class CountingWriter : public Writer {
+public:
+  std::size_t bytes = 0;
+
+protected:
+  void sink(const char *, std::size_t n) override { bytes += n; }
+};
+
+SCENARIO("The model is looked up by std::string_view", "[string_view]") {
+
+  GIVEN("an ExpenseTracker with a Category and some Items") {
+
+    ExpenseTracker etObj{};
+    Category &cObj = etObj.newCategory("Groceries and household shopping");
+    for (int i = 0; i < 100; i++) {
+      Item &item = cObj.newItem("item number " + std::to_string(i),
+                                "A description too long to fit in a string object", i,
+                                Date(2024, 12, 1 + i % 28));
+      item.addTag("weekly shopping at the supermarket");
+    }
+
+    // Views into a buffer, as when parsing a request or command line.
+    const std::string buffer = "Groceries and household shopping/item number 42/"
+                               "weekly shopping at the supermarket";
+    const std::string_view category(buffer.data(), 32);
+    const std::string_view item(buffer.data() + 33, 14);
+    const std::string_view tag(buffer.data() + 48);
+
+    WHEN("categories, items and tags are looked up") {
+
+      const std::size_t before = allocations;
+      const Item &found = etObj.getCategory(category).getItem(item);
+      const bool tagged = found.containsTag(tag);
+      const std::string_view description = found.getDescription();
+      const std::string &ident = found.getIdent();
+      const Money sum = etObj.getCategory(category).getSumForTag(tag);
+      const std::size_t made = allocations - before;
+
+      THEN("nothing is copied") {
+
+        REQUIRE(made == 0);
+        REQUIRE(tagged);
+        REQUIRE(description == "A description too long to fit in a string object");
+        REQUIRE(ident == "item number 42");
+        REQUIRE(sum == Money(4950));
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("the category is serialised") {
+
+      // The first serialisation after a change may sort the items (see HashMap).
+      const std::size_t expected = cObj.str().size();
+      CountingWriter out;
+      const std::size_t before = allocations;
+      cObj.write(out);
+      out.flush();
+      const std::size_t made = allocations - before;
+
+      THEN("no memory is allocated") {
+
+        REQUIRE(made == 0);
+        REQUIRE(out.bytes == expected);
+
+      } // THEN
+
+    } // WHEN
+
+    WHEN("an item and the category are deleted by view") {
+
+      REQUIRE(cObj.deleteItem(item));
+      REQUIRE_THROWS_AS(cObj.getItem(item), std::out_of_range);
+      REQUIRE(cObj.size() == 99);
+      REQUIRE(etObj.deleteCategory(category));
+
+      THEN("they are gone") {
+
+        REQUIRE_THROWS_AS(etObj.getCategory(category), std::out_of_range);
+        REQUIRE(etObj.size() == 0);
+
+      } // THEN
+
+    } // WHEN
+
+  } // GIVEN
+
+  GIVEN("tags interned from views") {
+
+    const std::string buffer = "first tag of test30,second tag of test30";
+    const TagId first = TagDictionary::intern(std::string_view(buffer.data(), 19));
+    const TagId second = TagDictionary::intern(std::string_view(buffer.data() + 20));
+
+    THEN("the dictionary keeps its own copies of the strings") {
+
+      REQUIRE(TagDictionary::name(first) == "first tag of test30");
+      REQUIRE(TagDictionary::name(second) == "second tag of test30");
+      TagId id = 0;
+      REQUIRE(TagDictionary::find("second tag of test30", id));
+      REQUIRE(id == second);
+      REQUIRE(TagDictionary::intern(std::string("first tag of test30")) == first);
+
+    } // THEN
+
+  } // GIVEN
+
+}